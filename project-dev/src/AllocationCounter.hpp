@@ -0,0 +1,10 @@
+#ifndef ALLOCATIONCOUNTER
+#define ALLOCATIONCOUNTER
+
+#include <cstdint>
+
+// Test hook: AllocationCounter.cpp replaces the global operator new of the test runner and counts every
+// allocation of every thread. It is only linked into the test runner.
+uint64_t allocationCount();
+
+#endif
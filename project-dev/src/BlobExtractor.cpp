@@ -0,0 +1,194 @@
+#include "BlobExtractor.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+const size_t ConeCandidates::CAPACITY;
+
+namespace
+{
+// Bytes of the scratch data of a mask with this many runs, including the padding between the arrays.
+size_t scratchBytes(size_t runs, size_t momentsSize)
+{
+    return runs * (2 * sizeof(int) + momentsSize) + 2 * alignof(std::max_align_t);
+}
+} // namespace
+
+const ConeCandidate &ConeCandidates::nearest() const
+{
+    size_t nearest = 0;
+    for (size_t i = 1; i < count; i++)
+    {
+        nearest = (items[i].bottom > items[nearest].bottom) ? i : nearest;
+    }
+    return items[nearest];
+}
+
+BlobExtractor::BlobExtractor(int maxWidth, int maxHeight)
+    : m_scratch{scratchSize(maxWidth, maxHeight)}, m_parent{nullptr}, m_moments{nullptr}, m_labels{0}, m_encodedMask{}
+{
+}
+
+size_t BlobExtractor::scratchSize(int width, int height)
+{
+    const size_t MAX_RUNS = static_cast<size_t>(height) * static_cast<size_t>(width / 2 + 1);
+    return scratchBytes(MAX_RUNS, sizeof(Moments));
+}
+
+int BlobExtractor::newLabel(int row)
+{
+    const int label = static_cast<int>(m_labels++);
+    m_parent[label] = label;
+    m_moments[label] = Moments{0, 0, 0, std::numeric_limits<int32_t>::max(), row, 0, 0};
+    return label;
+}
+
+int BlobExtractor::findRoot(int label)
+{
+    while (m_parent[label] != label)
+    {
+        // Path halving keeps the trees flat without recursion.
+        m_parent[label] = m_parent[m_parent[label]];
+        label = m_parent[label];
+    }
+    return label;
+}
+
+void BlobExtractor::unite(int a, int b)
+{
+    a = findRoot(a);
+    b = findRoot(b);
+    // The older label always becomes the root so that labelling is deterministic.
+    if (a < b)
+    {
+        m_parent[b] = a;
+    }
+    else if (b < a)
+    {
+        m_parent[a] = b;
+    }
+}
+
+ConeCandidates BlobExtractor::extract(const cv::Mat &mask, int minArea)
+{
+    m_encodedMask.assign(mask);
+    return extract(m_encodedMask, minArea);
+}
+
+ConeCandidates BlobExtractor::extract(const RunLengthMask &mask, int minArea)
+{
+    // Only a mask larger than expected needs a larger arena.
+    const size_t BYTES = scratchBytes(mask.runCount(), sizeof(Moments));
+    if (m_scratch.capacity() < BYTES)
+    {
+        m_scratch = FrameArena{BYTES};
+    }
+    const ConeCandidates CANDIDATES = extract(mask, minArea, m_scratch);
+    m_scratch.reset();
+    return CANDIDATES;
+}
+
+ConeCandidates BlobExtractor::extract(const RunLengthMask &mask, int minArea, FrameArena &scratch)
+{
+    // A label is created for a run at most, so the runs bound the labels.
+    int *runLabels = scratch.allocate<int>(mask.runCount());
+    m_parent = scratch.allocate<int>(mask.runCount());
+    m_moments = scratch.allocate<Moments>(mask.runCount());
+    m_labels = 0;
+
+    const MaskRun *firstRun = (mask.rows() > 0) ? mask.rowBegin(0) : nullptr;
+    for (int row = 0; row < mask.rows(); row++)
+    {
+        const MaskRun *candidate = (row > 0) ? mask.rowBegin(row - 1) : nullptr;
+        const MaskRun *previousRowEnd = (row > 0) ? mask.rowEnd(row - 1) : nullptr;
+        for (const MaskRun *run = mask.rowBegin(row); run != mask.rowEnd(row); run++)
+        {
+            // Runs of the previous row touch this one (8-connectivity) if they overlap [begin - 1, end].
+            int label = -1;
+            while (candidate != previousRowEnd && candidate->end < run->begin)
+            {
+                candidate++;
+            }
+            for (const MaskRun *other = candidate; other != previousRowEnd && other->begin <= run->end; other++)
+            {
+                const int otherLabel = runLabels[other - firstRun];
+                if (label < 0)
+                {
+                    label = otherLabel;
+                }
+                else
+                {
+                    unite(label, otherLabel);
+                }
+            }
+            if (label < 0)
+            {
+                label = newLabel(row);
+            }
+            runLabels[run - firstRun] = label;
+
+            // The x coordinates of a run sum up to length * (first + last) / 2, which is always integral.
+            const int64_t length = run->end - run->begin;
+            Moments &moments = m_moments[label];
+            moments.area += length;
+            moments.sumX += length * (run->begin + run->end - 1) / 2;
+            moments.sumY += length * row;
+            moments.left = std::min(moments.left, run->begin);
+            moments.right = std::max(moments.right, run->end);
+            moments.bottom = row + 1;
+        }
+    }
+
+    // Fold the moments of merged labels into their roots and keep the largest blobs.
+    ConeCandidates candidates{};
+    for (size_t label = 0; label < m_labels; label++)
+    {
+        const int root = findRoot(static_cast<int>(label));
+        if (root != static_cast<int>(label))
+        {
+            m_moments[root].area += m_moments[label].area;
+            m_moments[root].sumX += m_moments[label].sumX;
+            m_moments[root].sumY += m_moments[label].sumY;
+            m_moments[root].left = std::min(m_moments[root].left, m_moments[label].left);
+            m_moments[root].top = std::min(m_moments[root].top, m_moments[label].top);
+            m_moments[root].right = std::max(m_moments[root].right, m_moments[label].right);
+            m_moments[root].bottom = std::max(m_moments[root].bottom, m_moments[label].bottom);
+        }
+    }
+    for (size_t label = 0; label < m_labels; label++)
+    {
+        const Moments &moments = m_moments[label];
+        if (m_parent[label] != static_cast<int>(label) || moments.area <= minArea)
+        {
+            continue;
+        }
+        const ConeCandidate blob{static_cast<int>(moments.area),
+                                 static_cast<float>(static_cast<double>(moments.sumX) / static_cast<double>(moments.area)),
+                                 static_cast<float>(static_cast<double>(moments.sumY) / static_cast<double>(moments.area)),
+                                 moments.left, moments.top, moments.right, moments.bottom};
+
+        // Insertion into the fixed-size, area-sorted array; ties keep the blob found first.
+        size_t position = candidates.count;
+        while (position > 0 && candidates.items[position - 1].area < blob.area)
+        {
+            position--;
+        }
+        if (position >= ConeCandidates::CAPACITY)
+        {
+            continue;
+        }
+        const size_t last = (candidates.count < ConeCandidates::CAPACITY) ? candidates.count : ConeCandidates::CAPACITY - 1;
+        for (size_t i = last; i > position; i--)
+        {
+            candidates.items[i] = candidates.items[i - 1];
+        }
+        candidates.items[position] = blob;
+        if (candidates.count < ConeCandidates::CAPACITY)
+        {
+            candidates.count++;
+        }
+    }
+    return candidates;
+}
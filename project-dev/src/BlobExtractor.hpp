@@ -0,0 +1,97 @@
+#ifndef BLOBEXTRACTOR
+#define BLOBEXTRACTOR
+
+#include "FrameArena.hpp"
+#include "RunLengthMask.hpp"
+
+#include <opencv2/core/core.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A connected blob of mask pixels that may be a cone.
+struct ConeCandidate
+{
+    int area; // number of pixels
+    float x;  // centroid
+    float y;
+    int left; // bounding box, right and bottom exclusive
+    int top;
+    int right;
+    int bottom;
+
+    cv::Point2f centroid() const { return cv::Point2f(x, y); }
+    cv::Rect boundingBox() const { return cv::Rect(left, top, right - left, bottom - top); }
+};
+
+// Which candidate of a colour is steered for.
+enum class ConeSelection
+{
+    LARGEST,
+    NEAREST // the one reaching furthest down the band, i.e. closest to the car
+};
+
+// Fixed-capacity list of cone candidates sorted by area, largest first.
+struct ConeCandidates
+{
+    static const size_t CAPACITY = 16;
+    ConeCandidate items[CAPACITY];
+    size_t count;
+
+    bool empty() const { return count == 0; }
+    const ConeCandidate &largest() const { return items[0]; }
+    // The larger one of candidates reaching equally far down.
+    const ConeCandidate &nearest() const;
+    const ConeCandidate &selected(ConeSelection selection) const { return selection == ConeSelection::NEAREST ? nearest() : largest(); }
+    const ConeCandidate *begin() const { return items; }
+    const ConeCandidate *end() const { return items + count; }
+};
+
+// Labels the 8-connected blobs of a run-length encoded mask in a single pass over its runs,
+// merging labels with union-find and accumulating area, first-order moments and bounding box per label. The label
+// and moment scratch is taken from a FrameArena for the number of runs of the mask at hand; without
+// an arena of the caller the extractor uses its own, sized once for the expected mask size.
+class BlobExtractor
+{
+private:
+    struct Moments
+    {
+        int64_t area;
+        int64_t sumX;
+        int64_t sumY;
+        int32_t left;
+        int32_t top;
+        int32_t right;
+        int32_t bottom;
+    };
+
+    FrameArena m_scratch;
+    int *m_parent;
+    Moments *m_moments;
+    size_t m_labels;
+    RunLengthMask m_encodedMask;
+
+    // A label starts on the row of its first run, which is the top of its part of the blob.
+    int newLabel(int row);
+    int findRoot(int label);
+    void unite(int a, int b);
+
+public:
+    BlobExtractor(int maxWidth, int maxHeight);
+    BlobExtractor(const BlobExtractor &) = delete;
+    BlobExtractor &operator=(const BlobExtractor &) = delete;
+
+    // Arena bytes extract() needs for a mask of the given size in the worst case (a checkerboard:
+    // one run every second pixel, and a new label for every run).
+    static size_t scratchSize(int width, int height);
+
+    // Returns the blobs with more than minArea pixels.
+    ConeCandidates extract(const RunLengthMask &mask, int minArea);
+    // Same, with the scratch data allocated from the given arena, which the caller resets.
+    ConeCandidates extract(const RunLengthMask &mask, int minArea, FrameArena &scratch);
+    // Same for a CV_8UC1 mask with non-zero pixels set, which is run-length encoded first.
+    ConeCandidates extract(const cv::Mat &mask, int minArea);
+};
+
+#endif
@@ -0,0 +1,67 @@
+#include "CatchUpPolicy.hpp"
+
+const uint32_t CatchUp::DEGRADED_FRAMES;
+
+bool parseCatchUpPolicy(const std::string &name, CatchUpPolicy &policy)
+{
+    if (name == "latest")
+    {
+        policy = CatchUpPolicy::LATEST;
+    }
+    else if (name == "backlog")
+    {
+        policy = CatchUpPolicy::BACKLOG;
+    }
+    else if (name == "degrade")
+    {
+        policy = CatchUpPolicy::DEGRADE;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+const char *catchUpPolicyName(CatchUpPolicy policy)
+{
+    switch (policy)
+    {
+    case CatchUpPolicy::LATEST:
+        return "latest";
+    case CatchUpPolicy::BACKLOG:
+        return "backlog";
+    case CatchUpPolicy::DEGRADE:
+        return "degrade";
+    }
+    return "";
+}
+
+size_t catchUpFrameSlots(CatchUpPolicy policy, size_t stages, size_t backlog)
+{
+    const size_t SLOTS = (policy == CatchUpPolicy::BACKLOG) ? stages + backlog : stages;
+    return SLOTS > 0 ? SLOTS : 1;
+}
+
+CatchUp::CatchUp(CatchUpPolicy policy)
+    : m_policy{policy}, m_degradedFrames{0}
+{
+}
+
+bool CatchUp::degrade(int64_t periods)
+{
+    if (m_policy != CatchUpPolicy::DEGRADE)
+    {
+        return false;
+    }
+    if (periods > 1)
+    {
+        m_degradedFrames = DEGRADED_FRAMES;
+    }
+    if (m_degradedFrames == 0)
+    {
+        return false;
+    }
+    m_degradedFrames--;
+    return true;
+}
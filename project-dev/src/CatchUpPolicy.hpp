@@ -0,0 +1,50 @@
+#ifndef CATCHUPPOLICY
+#define CATCHUPPOLICY
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// What happens when processing a frame takes longer than one frame period. The shared memory only holds
+// the newest frame, so frames the producer writes while we are busy are always lost; the policies differ
+// in how many frames may wait between the stages and in whether the processing gets cheaper.
+//  - LATEST:  at most one frame per stage, so the next frame acquired is always the newest one.
+//  - BACKLOG: in addition, up to a bounded number of frames are queued between the stages.
+//  - DEGRADE: like LATEST, and after frames were lost the following frames are processed degraded
+//             (no debug drawing, segmentation of every other row) until the pipeline kept up again.
+// In all policies a wake-up that delivers the previous frame again is not processed.
+enum class CatchUpPolicy
+{
+    LATEST,
+    BACKLOG,
+    DEGRADE
+};
+
+// Parses "latest", "backlog" or "degrade"; returns false for anything else.
+bool parseCatchUpPolicy(const std::string &name, CatchUpPolicy &policy);
+const char *catchUpPolicyName(CatchUpPolicy policy);
+
+// Frame slots of the threaded pipeline for the policy: one per stage, plus the backlog for BACKLOG.
+size_t catchUpFrameSlots(CatchUpPolicy policy, size_t stages, size_t backlog);
+
+// Decides from the gaps reported by FrameTiming which frames are processed degraded.
+class CatchUp
+{
+private:
+    CatchUpPolicy m_policy;
+    uint32_t m_degradedFrames;
+
+public:
+    // Frames that are processed degraded after frames were lost.
+    static const uint32_t DEGRADED_FRAMES = 30;
+
+    explicit CatchUp(CatchUpPolicy policy);
+
+    // Takes the frame periods since the previous frame (more than 1 means frames were lost) and
+    // returns whether this frame is processed degraded.
+    bool degrade(int64_t periods);
+
+    CatchUpPolicy policy() const { return m_policy; }
+};
+
+#endif
@@ -0,0 +1,84 @@
+#include "ConeColorTable.hpp"
+#include "ConeSegmentation.hpp"
+
+const uint8_t ConeColorTable::BLUE;
+const uint8_t ConeColorTable::YELLOW;
+const int ConeColorTable::MIN_BITS_PER_CHANNEL;
+const int ConeColorTable::MAX_BITS_PER_CHANNEL;
+
+ConeColorTable::ConeColorTable(const HsvRange &blue, const HsvRange &yellow, int bitsPerChannel)
+    : m_bitsPerChannel{bitsPerChannel}, m_shift{8 - bitsPerChannel}, m_cells{}
+{
+    CV_Assert(validBitsPerChannel(bitsPerChannel));
+    const int LEVELS = 1 << m_bitsPerChannel;
+    const int CENTRE = (m_shift > 0) ? (1 << (m_shift - 1)) : 0;
+    m_cells.assign((static_cast<size_t>(1) << (3 * m_bitsPerChannel)) / 4 + 1, 0);
+
+    // Classify the cell centres with the exact kernel, one red level (a LEVELS x LEVELS image) at a time.
+    cv::Mat centres(LEVELS, LEVELS, CV_8UC4);
+    cv::Mat blueMask, yellowMask;
+    for (int r = 0; r < LEVELS; r++)
+    {
+        for (int g = 0; g < LEVELS; g++)
+        {
+            uint8_t *px = centres.ptr<uint8_t>(g);
+            for (int b = 0; b < LEVELS; b++)
+            {
+                px[4 * b + 0] = static_cast<uint8_t>((b << m_shift) | CENTRE);
+                px[4 * b + 1] = static_cast<uint8_t>((g << m_shift) | CENTRE);
+                px[4 * b + 2] = static_cast<uint8_t>((r << m_shift) | CENTRE);
+                px[4 * b + 3] = 0;
+            }
+        }
+        segmentCones(centres, blue, yellow, blueMask, yellowMask);
+
+        for (int g = 0; g < LEVELS; g++)
+        {
+            const uint8_t *blueRow = blueMask.ptr<uint8_t>(g);
+            const uint8_t *yellowRow = yellowMask.ptr<uint8_t>(g);
+            for (int b = 0; b < LEVELS; b++)
+            {
+                const uint8_t cls = static_cast<uint8_t>((blueRow[b] ? BLUE : 0) | (yellowRow[b] ? YELLOW : 0));
+                const uint32_t cell = (static_cast<uint32_t>(r) << (2 * m_bitsPerChannel)) | (static_cast<uint32_t>(g) << m_bitsPerChannel) | static_cast<uint32_t>(b);
+                m_cells[cell >> 2] = static_cast<uint8_t>(m_cells[cell >> 2] | (cls << ((cell & 3) << 1)));
+            }
+        }
+    }
+}
+
+void ConeColorTable::segmentRow(const uint8_t *pixels, int count, uint8_t *blueRow, uint8_t *yellowRow) const
+{
+    for (int col = 0; col < count; col++, pixels += 4)
+    {
+        const uint8_t cls = classify(pixels[0], pixels[1], pixels[2]);
+        // Turn the class bits into 0/255 without branching.
+        blueRow[col] = static_cast<uint8_t>(-(cls & BLUE));
+        yellowRow[col] = static_cast<uint8_t>(-((cls & YELLOW) >> 1));
+    }
+}
+
+void ConeColorTable::segment(const cv::Mat &bgraImage, cv::Mat &blueMask, cv::Mat &yellowMask) const
+{
+    CV_Assert(bgraImage.type() == CV_8UC4);
+    blueMask.create(bgraImage.rows, bgraImage.cols, CV_8UC1);
+    yellowMask.create(bgraImage.rows, bgraImage.cols, CV_8UC1);
+
+    for (int row = 0; row < bgraImage.rows; row++)
+    {
+        segmentRow(bgraImage.ptr<uint8_t>(row), bgraImage.cols, blueMask.ptr<uint8_t>(row), yellowMask.ptr<uint8_t>(row));
+    }
+}
+
+void ConeColorTable::segment(const cv::Mat &bgraImage, RunLengthMask &blueMask, RunLengthMask &yellowMask) const
+{
+    CV_Assert(bgraImage.type() == CV_8UC4);
+    blueMask.reset(bgraImage.rows, bgraImage.cols);
+    yellowMask.reset(bgraImage.rows, bgraImage.cols);
+
+    for (int row = 0; row < bgraImage.rows; row++)
+    {
+        segmentRow(bgraImage.ptr<uint8_t>(row), bgraImage.cols, blueMask.scratchRow(), yellowMask.scratchRow());
+        blueMask.appendRow(blueMask.scratchRow());
+        yellowMask.appendRow(yellowMask.scratchRow());
+    }
+}
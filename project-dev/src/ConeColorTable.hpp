@@ -0,0 +1,52 @@
+#ifndef CONECOLORTABLE
+#define CONECOLORTABLE
+
+#include "ConeColors.hpp"
+#include "RunLengthMask.hpp"
+
+#include <opencv2/core/core.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// Lookup table that maps a quantized BGR colour directly to its cone class, replacing the per-pixel
+// HSV conversion. Every cell stores 2 bits (bit 0: blue, bit 1: yellow) and is classified by the colour
+// at its centre. With 8 bits per channel the table is exact (4 MB); with 6 bits it takes 64 KB.
+class ConeColorTable
+{
+private:
+    int m_bitsPerChannel;
+    int m_shift;
+    std::vector<uint8_t> m_cells;
+
+    void segmentRow(const uint8_t *pixels, int count, uint8_t *blueRow, uint8_t *yellowRow) const;
+
+public:
+    static const uint8_t BLUE = 1;
+    static const uint8_t YELLOW = 2;
+    static const int MIN_BITS_PER_CHANNEL = 1;
+    static const int MAX_BITS_PER_CHANNEL = 8;
+
+    // bitsPerChannel must lie within [MIN_BITS_PER_CHANNEL, MAX_BITS_PER_CHANNEL].
+    ConeColorTable(const HsvRange &blue, const HsvRange &yellow, int bitsPerChannel = 6);
+
+    static bool validBitsPerChannel(int bitsPerChannel) { return bitsPerChannel >= MIN_BITS_PER_CHANNEL && bitsPerChannel <= MAX_BITS_PER_CHANNEL; }
+
+    int bitsPerChannel() const { return m_bitsPerChannel; }
+    size_t sizeInBytes() const { return m_cells.size(); }
+
+    uint8_t classify(uint8_t b, uint8_t g, uint8_t r) const
+    {
+        const uint32_t cell = (static_cast<uint32_t>(r >> m_shift) << (2 * m_bitsPerChannel)) |
+                              (static_cast<uint32_t>(g >> m_shift) << m_bitsPerChannel) |
+                              static_cast<uint32_t>(b >> m_shift);
+        return (m_cells[cell >> 2] >> ((cell & 3) << 1)) & 3;
+    }
+
+    // Same contract as segmentCones(): CV_8UC1 masks with 255 for blue and yellow pixels respectively.
+    void segment(const cv::Mat &bgraImage, cv::Mat &blueMask, cv::Mat &yellowMask) const;
+    // Emits run-length encoded masks directly, like the corresponding segmentCones().
+    void segment(const cv::Mat &bgraImage, RunLengthMask &blueMask, RunLengthMask &yellowMask) const;
+};
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef CONECOLORS
+#define CONECOLORS
+
+// Inclusive HSV range (OpenCV 8-bit scale: hue 0-180, saturation and value 0-255) of one cone colour.
+struct HsvRange
+{
+    int minHue;
+    int maxHue;
+    int minSat;
+    int maxSat;
+    int minVal;
+    int maxVal;
+};
+
+// Yellow hsv values
+const int MIN_HUE_Y = 15;
+const int MAX_HUE_Y = 25;
+const int MIN_SAT_Y = 75;
+const int MAX_SAT_Y = 185;
+const int MIN_VAL_Y = 147;
+const int MAX_VAL_Y = 255;
+
+// Blue hsv values
+const int MIN_HUE_B = 100;
+const int MAX_HUE_B = 140;
+const int MIN_SAT_B = 120;
+const int MAX_SAT_B = 255;
+const int MIN_VAL_B = 40;
+const int MAX_VAL_B = 255;
+
+const HsvRange YELLOW_CONE_RANGE{MIN_HUE_Y, MAX_HUE_Y, MIN_SAT_Y, MAX_SAT_Y, MIN_VAL_Y, MAX_VAL_Y};
+const HsvRange BLUE_CONE_RANGE{MIN_HUE_B, MAX_HUE_B, MIN_SAT_B, MAX_SAT_B, MIN_VAL_B, MAX_VAL_B};
+
+#endif
@@ -0,0 +1,201 @@
+#include "ConeDetector.hpp"
+#include "ConeSegmentation.hpp"
+
+#include <opencv2/imgproc/imgproc.hpp>
+
+namespace
+{
+// Draws the mask of the window and the bounding boxes and centroids of all cone candidates of one colour.
+void drawCones(cv::Mat &debugImage, cv::Mat &window, const RunLengthMask &mask, const ConeCandidates &candidates, cv::Scalar maskColor, cv::Scalar centroidColor)
+{
+    mask.draw(window, maskColor);
+    for (const ConeCandidate &candidate : candidates)
+    {
+        cv::rectangle(debugImage, candidate.boundingBox(), maskColor, 1);
+        cv::circle(debugImage, candidate.centroid(), 4, centroidColor, -1, 8, 0);
+    }
+}
+
+// Whether only a window of the band is searched.
+bool hasWindow(const Frame &frame)
+{
+    return frame.window.width > 0 && frame.window.height > 0;
+}
+
+// The part of the band that is searched, as a view without copying.
+cv::Mat searchedBand(const Frame &frame)
+{
+    return hasWindow(frame) ? frame.band(frame.window) : frame.band;
+}
+
+// Moves candidates found in the searched part of the band into the rows and columns of the band: by the
+// offset of the window and, for every other row, to twice the row.
+void toBandCoordinates(ConeCandidates &candidates, int dx, int dy, int rowStep)
+{
+    for (size_t i = 0; i < candidates.count; i++)
+    {
+        ConeCandidate &candidate = candidates.items[i];
+        candidate.x += static_cast<float>(dx);
+        candidate.y = candidate.y * static_cast<float>(rowStep) + static_cast<float>(dy);
+        candidate.left += dx;
+        candidate.right += dx;
+        candidate.top = candidate.top * rowStep + dy;
+        candidate.bottom = candidate.bottom * rowStep + dy;
+    }
+}
+
+// Every other row of the band, as a view without copying.
+cv::Mat everyOtherRow(const cv::Mat &band)
+{
+    return cv::Mat((band.rows + 1) / 2, band.cols, band.type(), band.data, band.step * 2);
+}
+
+// The centre point of the selected cone, or (0, 0) if there is none.
+cv::Point2f selectedCone(const ConeCandidates &candidates, ConeSelection selection)
+{
+    return candidates.empty() ? cv::Point2f() : candidates.selected(selection).centroid();
+}
+} // namespace
+
+ConeDetector::ConeDetector(int bandWidth, int bandHeight, bool exactSegmentation, int lutBits, bool drawDebug, size_t threads, ConeSelection selection)
+    : m_colorTable{}, m_blueExtractor{bandWidth, bandHeight}, m_yellowExtractor{bandWidth, bandHeight},
+      m_blueScratch{BlobExtractor::scratchSize(bandWidth, bandHeight)}, m_yellowScratch{BlobExtractor::scratchSize(bandWidth, bandHeight)}, m_drawDebug{drawDebug}, m_selection{selection},
+      m_segmentationPool{}, m_detectionPool{}, m_blueChunks{}, m_yellowChunks{}, m_segmentTask{}, m_detectTask{},
+      m_band{nullptr}, m_frame{nullptr}, m_minArea{MIN_CONE_AREA}
+{
+    // The HSV thresholds are constant, so the colour classification is precomputed once.
+    if (!exactSegmentation)
+    {
+        m_colorTable.reset(new ConeColorTable{BLUE_CONE_RANGE, YELLOW_CONE_RANGE, lutBits});
+    }
+    if (threads > 1)
+    {
+        m_segmentationPool.reset(new WorkerPool{threads - 1});
+        m_detectionPool.reset(new WorkerPool{1});
+        m_blueChunks.resize(threads);
+        m_yellowChunks.resize(threads);
+        // The chunk masks are sized for the largest chunk up front.
+        const int CHUNK_ROWS = (bandHeight + static_cast<int>(threads) - 1) / static_cast<int>(threads);
+        for (size_t chunk = 0; chunk < threads; chunk++)
+        {
+            m_blueChunks[chunk].reset(CHUNK_ROWS, bandWidth);
+            m_yellowChunks[chunk].reset(CHUNK_ROWS, bandWidth);
+        }
+    }
+
+    m_segmentTask = [this](size_t chunk) {
+        const int ROWS = m_band->rows;
+        const int CHUNKS = static_cast<int>(m_blueChunks.size());
+        const int first = ROWS * static_cast<int>(chunk) / CHUNKS;
+        const int last = ROWS * (static_cast<int>(chunk) + 1) / CHUNKS;
+        segmentBand(m_band->rowRange(first, last), m_blueChunks[chunk], m_yellowChunks[chunk]);
+    };
+    m_detectTask = [this](size_t colour) {
+        if (colour == 0)
+        {
+            m_frame->blueCandidates = m_blueExtractor.extract(m_frame->blueMask, m_minArea, m_blueScratch);
+        }
+        else
+        {
+            m_frame->yellowCandidates = m_yellowExtractor.extract(m_frame->yellowMask, m_minArea, m_yellowScratch);
+        }
+    };
+}
+
+size_t ConeDetector::colorTableSize() const
+{
+    return m_colorTable ? m_colorTable->sizeInBytes() : 0;
+}
+
+size_t ConeDetector::scratchHighWater() const
+{
+    return m_blueScratch.highWater() + m_yellowScratch.highWater();
+}
+
+size_t ConeDetector::scratchCapacity() const
+{
+    return m_blueScratch.capacity() + m_yellowScratch.capacity();
+}
+
+void ConeDetector::segmentBand(const cv::Mat &band, RunLengthMask &blueMask, RunLengthMask &yellowMask) const
+{
+    // Classify the pixels of the band as blue or yellow cone in a single pass into run-length encoded masks
+    if (m_colorTable)
+    {
+        m_colorTable->segment(band, blueMask, yellowMask);
+    }
+    else
+    {
+        segmentCones(band, BLUE_CONE_RANGE, YELLOW_CONE_RANGE, blueMask, yellowMask);
+    }
+}
+
+void ConeDetector::segment(Frame &frame)
+{
+    const cv::Mat searched = searchedBand(frame);
+    const cv::Mat band = frame.degraded ? everyOtherRow(searched) : searched;
+    if (!m_segmentationPool)
+    {
+        segmentBand(band, frame.blueMask, frame.yellowMask);
+        return;
+    }
+
+    m_band = &band;
+    m_segmentationPool->run(m_blueChunks.size(), m_segmentTask);
+    m_band = nullptr;
+
+    const int ROWS = band.rows;
+
+    // Stitching the chunks only copies runs, which are few compared to the pixels.
+    frame.blueMask.reset(ROWS, band.cols);
+    frame.yellowMask.reset(ROWS, band.cols);
+    for (size_t chunk = 0; chunk < m_blueChunks.size(); chunk++)
+    {
+        frame.blueMask.appendRows(m_blueChunks[chunk]);
+        frame.yellowMask.appendRows(m_yellowChunks[chunk]);
+    }
+}
+
+void ConeDetector::detect(Frame &frame)
+{
+    // Half the rows of a degraded frame hold half the pixels of a cone.
+    const int MIN_AREA = frame.degraded ? MIN_CONE_AREA / 2 : MIN_CONE_AREA;
+    if (m_detectionPool)
+    {
+        m_frame = &frame;
+        m_minArea = MIN_AREA;
+        m_detectionPool->run(2, m_detectTask);
+        m_frame = nullptr;
+    }
+    else
+    {
+        frame.blueCandidates = m_blueExtractor.extract(frame.blueMask, MIN_AREA, m_blueScratch);
+        frame.yellowCandidates = m_yellowExtractor.extract(frame.yellowMask, MIN_AREA, m_yellowScratch);
+    }
+    // The candidates are copied into the frame, so the scratch data of this frame can go.
+    m_blueScratch.reset();
+    m_yellowScratch.reset();
+    if (hasWindow(frame) || frame.degraded)
+    {
+        const int ROW_STEP = frame.degraded ? 2 : 1;
+        toBandCoordinates(frame.blueCandidates, frame.window.x, frame.window.y, ROW_STEP);
+        toBandCoordinates(frame.yellowCandidates, frame.window.x, frame.window.y, ROW_STEP);
+    }
+    frame.blueCone = selectedCone(frame.blueCandidates, m_selection);
+    frame.yellowCone = selectedCone(frame.yellowCandidates, m_selection);
+
+    // The cone pixels and centroids are only drawn when the image is displayed
+    if (m_drawDebug && !frame.degraded)
+    {
+        cv::Scalar blue = cv::Scalar(255,0,0);
+        cv::Scalar red = cv::Scalar(0,0,255);
+        cv::Scalar green = cv::Scalar(0,255,0);
+        cv::Mat window = searchedBand(frame);
+        drawCones(frame.band, window, frame.blueMask, frame.blueCandidates, blue, red);
+        drawCones(frame.band, window, frame.yellowMask, frame.yellowCandidates, green, red);
+        if (hasWindow(frame))
+        {
+            cv::rectangle(frame.band, frame.window, cv::Scalar(255, 255, 255), 1);
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef CONEDETECTOR
+#define CONEDETECTOR
+
+#include "BlobExtractor.hpp"
+#include "ConeColorTable.hpp"
+#include "Frame.hpp"
+#include "WorkerPool.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Blobs with at most this many pixels are ignored.
+const int MIN_CONE_AREA = 75;
+// More threads than this only split the band into chunks of a few rows that are not worth a thread.
+const int MAX_DETECTION_THREADS = 16;
+
+// Finds the blue and the yellow cones in the band of a frame: segment() classifies the pixels into
+// run-length encoded masks, detect() labels the blobs into the candidates of each colour and picks the
+// cone to steer for among them, the largest or the nearest one.
+//
+// With more than one thread, segment() splits the band into horizontal chunks that are classified
+// concurrently (the fused kernel produces both colours in one pass, so splitting by colour would
+// convert every pixel twice) and detect() extracts the blue and the yellow blobs concurrently.
+// Both use their own persistent worker pool, so they may run on different threads.
+//
+// Only the window of the frame is searched when it has one; the candidates are moved into the coordinates
+// of the band, so the stages after the detection do not depend on it.
+//
+// A degraded frame is segmented at half the vertical resolution (every other row of the band, so the
+// masks have half the rows and the blobs half the area) and nothing is drawn onto it. The positions and
+// bounding boxes of its candidates are still in rows of the band.
+class ConeDetector
+{
+private:
+    std::unique_ptr<ConeColorTable> m_colorTable;
+    BlobExtractor m_blueExtractor;
+    BlobExtractor m_yellowExtractor;
+    // Scratch data of the detection of one frame, per colour as both may be extracted concurrently.
+    FrameArena m_blueScratch;
+    FrameArena m_yellowScratch;
+    bool m_drawDebug;
+    ConeSelection m_selection;
+    std::unique_ptr<WorkerPool> m_segmentationPool;
+    std::unique_ptr<WorkerPool> m_detectionPool;
+    std::vector<RunLengthMask> m_blueChunks;
+    std::vector<RunLengthMask> m_yellowChunks;
+
+    // The tasks of the worker pools are created once; they work on the band and frame set by the
+    // current call, so handing them to the pools does not allocate per frame.
+    std::function<void(size_t)> m_segmentTask;
+    std::function<void(size_t)> m_detectTask;
+    const cv::Mat *m_band;
+    Frame *m_frame;
+    int m_minArea;
+
+    void segmentBand(const cv::Mat &band, RunLengthMask &blueMask, RunLengthMask &yellowMask) const;
+
+public:
+    // Without exactSegmentation the pixels are classified with a lookup table of lutBits per channel.
+    // With drawDebug the masks, bounding boxes and centroids are drawn onto the band.
+    ConeDetector(int bandWidth, int bandHeight, bool exactSegmentation, int lutBits, bool drawDebug, size_t threads = 1,
+                 ConeSelection selection = ConeSelection::LARGEST);
+    ConeDetector(const ConeDetector &) = delete;
+    ConeDetector &operator=(const ConeDetector &) = delete;
+
+    // Size of the colour lookup table, 0 when the exact HSV conversion is used.
+    size_t colorTableSize() const;
+
+    void segment(Frame &frame);
+    void detect(Frame &frame);
+
+    // Most scratch bytes the detection of a frame needed so far, of the bytes reserved.
+    size_t scratchHighWater() const;
+    size_t scratchCapacity() const;
+};
+
+#endif
@@ -0,0 +1,285 @@
+#include "ConeSegmentation.hpp"
+
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define CONESEGMENTATION_X86
+#include <immintrin.h>
+#endif
+
+namespace
+{
+// Fixed-point precision and division tables of OpenCV's 8-bit BGR to HSV conversion (RGB2HSV_b).
+// Using the same tables and rounding is what makes the fused kernel bit-identical to cv::cvtColor.
+const int HSV_SHIFT = 12;
+const int HSV_ROUND = 1 << (HSV_SHIFT - 1);
+const int HUE_RANGE = 180;
+
+struct HsvTables
+{
+    int sdiv[256]{};
+    int hdiv[256]{};
+    // Byte masks for every combination of 8 pixel flags, used to expand SIMD compare results.
+    uint64_t byteMasks[256]{};
+
+    HsvTables()
+    {
+        for (int i = 1; i < 256; i++)
+        {
+            sdiv[i] = static_cast<int>(std::lrint((255 << HSV_SHIFT) / (1. * i)));
+            hdiv[i] = static_cast<int>(std::lrint((HUE_RANGE << HSV_SHIFT) / (6. * i)));
+        }
+        for (int bits = 0; bits < 256; bits++)
+        {
+            for (int i = 0; i < 8; i++)
+            {
+                if (bits & (1 << i))
+                {
+                    byteMasks[bits] |= static_cast<uint64_t>(0xFF) << (8 * i);
+                }
+            }
+        }
+    }
+};
+
+const HsvTables &hsvTables()
+{
+    static const HsvTables TABLES;
+    return TABLES;
+}
+
+inline bool isInRange(int h, int s, int v, const HsvRange &range)
+{
+    return h >= range.minHue && h <= range.maxHue &&
+           s >= range.minSat && s <= range.maxSat &&
+           v >= range.minVal && v <= range.maxVal;
+}
+
+void segmentRowScalar(const uint8_t *src, int count, const HsvRange &blue, const HsvRange &yellow,
+                      uint8_t *blueRow, uint8_t *yellowRow)
+{
+    const HsvTables &tables = hsvTables();
+    for (int i = 0; i < count; i++, src += 4)
+    {
+        const int b = src[0];
+        const int g = src[1];
+        const int r = src[2];
+        const int v = std::max(std::max(b, g), r);
+        const int diff = v - std::min(std::min(b, g), r);
+        const int vr = (v == r) ? -1 : 0;
+        const int vg = (v == g) ? -1 : 0;
+
+        const int s = (diff * tables.sdiv[v] + HSV_ROUND) >> HSV_SHIFT;
+        int h = (vr & (g - b)) + (~vr & ((vg & (b - r + 2 * diff)) + ((~vg) & (r - g + 4 * diff))));
+        h = (h * tables.hdiv[diff] + HSV_ROUND) >> HSV_SHIFT;
+        h += (h < 0) ? HUE_RANGE : 0;
+
+        blueRow[i] = isInRange(h, s, v, blue) ? 255 : 0;
+        yellowRow[i] = isInRange(h, s, v, yellow) ? 255 : 0;
+    }
+}
+
+#ifdef CONESEGMENTATION_X86
+// Inclusive bounds turned into exclusive ones so that the checks need only signed greater-than compares.
+struct ExclusiveBounds
+{
+    int lowHue;
+    int highHue;
+    int lowSat;
+    int highSat;
+    int lowVal;
+    int highVal;
+};
+
+ExclusiveBounds exclusiveBounds(const HsvRange &range)
+{
+    return ExclusiveBounds{range.minHue - 1, range.maxHue + 1, range.minSat - 1, range.maxSat + 1, range.minVal - 1, range.maxVal + 1};
+}
+
+__attribute__((target("sse4.1"))) inline __m128i inRangeSse41(__m128i h, __m128i s, __m128i v, const ExclusiveBounds &bounds)
+{
+    __m128i mask = _mm_and_si128(_mm_cmpgt_epi32(h, _mm_set1_epi32(bounds.lowHue)), _mm_cmplt_epi32(h, _mm_set1_epi32(bounds.highHue)));
+    mask = _mm_and_si128(mask, _mm_and_si128(_mm_cmpgt_epi32(s, _mm_set1_epi32(bounds.lowSat)), _mm_cmplt_epi32(s, _mm_set1_epi32(bounds.highSat))));
+    return _mm_and_si128(mask, _mm_and_si128(_mm_cmpgt_epi32(v, _mm_set1_epi32(bounds.lowVal)), _mm_cmplt_epi32(v, _mm_set1_epi32(bounds.highVal))));
+}
+
+// Four pixels per iteration; SSE4.1 has no gather, so the two table lookups are done per lane.
+__attribute__((target("sse4.1"))) void segmentRowSse41(const uint8_t *src, int count, const HsvRange &blue, const HsvRange &yellow,
+                                                       uint8_t *blueRow, uint8_t *yellowRow)
+{
+    const HsvTables &tables = hsvTables();
+    const ExclusiveBounds BLUE{exclusiveBounds(blue)};
+    const ExclusiveBounds YELLOW{exclusiveBounds(yellow)};
+    const __m128i BYTE = _mm_set1_epi32(0xFF);
+    const __m128i ROUND = _mm_set1_epi32(HSV_ROUND);
+    const __m128i ZERO = _mm_setzero_si128();
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 4 * i));
+        const __m128i b = _mm_and_si128(px, BYTE);
+        const __m128i g = _mm_and_si128(_mm_srli_epi32(px, 8), BYTE);
+        const __m128i r = _mm_and_si128(_mm_srli_epi32(px, 16), BYTE);
+        const __m128i v = _mm_max_epi32(_mm_max_epi32(b, g), r);
+        const __m128i diff = _mm_sub_epi32(v, _mm_min_epi32(_mm_min_epi32(b, g), r));
+        const __m128i vr = _mm_cmpeq_epi32(v, r);
+        const __m128i vg = _mm_cmpeq_epi32(v, g);
+
+        const __m128i sdiv = _mm_setr_epi32(tables.sdiv[_mm_extract_epi32(v, 0)], tables.sdiv[_mm_extract_epi32(v, 1)],
+                                            tables.sdiv[_mm_extract_epi32(v, 2)], tables.sdiv[_mm_extract_epi32(v, 3)]);
+        const __m128i hdiv = _mm_setr_epi32(tables.hdiv[_mm_extract_epi32(diff, 0)], tables.hdiv[_mm_extract_epi32(diff, 1)],
+                                            tables.hdiv[_mm_extract_epi32(diff, 2)], tables.hdiv[_mm_extract_epi32(diff, 3)]);
+        const __m128i s = _mm_srai_epi32(_mm_add_epi32(_mm_mullo_epi32(diff, sdiv), ROUND), HSV_SHIFT);
+
+        const __m128i twoDiff = _mm_add_epi32(diff, diff);
+        const __m128i hueR = _mm_sub_epi32(g, b);
+        const __m128i hueG = _mm_add_epi32(_mm_sub_epi32(b, r), twoDiff);
+        const __m128i hueB = _mm_add_epi32(_mm_sub_epi32(r, g), _mm_add_epi32(twoDiff, twoDiff));
+        __m128i h = _mm_add_epi32(_mm_and_si128(vr, hueR),
+                                  _mm_andnot_si128(vr, _mm_add_epi32(_mm_and_si128(vg, hueG), _mm_andnot_si128(vg, hueB))));
+        h = _mm_srai_epi32(_mm_add_epi32(_mm_mullo_epi32(h, hdiv), ROUND), HSV_SHIFT);
+        h = _mm_add_epi32(h, _mm_and_si128(_mm_cmplt_epi32(h, ZERO), _mm_set1_epi32(HUE_RANGE)));
+
+        const int blueBits = _mm_movemask_ps(_mm_castsi128_ps(inRangeSse41(h, s, v, BLUE)));
+        const int yellowBits = _mm_movemask_ps(_mm_castsi128_ps(inRangeSse41(h, s, v, YELLOW)));
+        const uint32_t blueBytes = static_cast<uint32_t>(tables.byteMasks[blueBits]);
+        const uint32_t yellowBytes = static_cast<uint32_t>(tables.byteMasks[yellowBits]);
+        std::memcpy(blueRow + i, &blueBytes, sizeof(blueBytes));
+        std::memcpy(yellowRow + i, &yellowBytes, sizeof(yellowBytes));
+    }
+    segmentRowScalar(src + 4 * i, count - i, blue, yellow, blueRow + i, yellowRow + i);
+}
+
+__attribute__((target("avx2"))) inline __m256i inRangeAvx2(__m256i h, __m256i s, __m256i v, const ExclusiveBounds &bounds)
+{
+    __m256i mask = _mm256_and_si256(_mm256_cmpgt_epi32(h, _mm256_set1_epi32(bounds.lowHue)), _mm256_cmpgt_epi32(_mm256_set1_epi32(bounds.highHue), h));
+    mask = _mm256_and_si256(mask, _mm256_and_si256(_mm256_cmpgt_epi32(s, _mm256_set1_epi32(bounds.lowSat)), _mm256_cmpgt_epi32(_mm256_set1_epi32(bounds.highSat), s)));
+    return _mm256_and_si256(mask, _mm256_and_si256(_mm256_cmpgt_epi32(v, _mm256_set1_epi32(bounds.lowVal)), _mm256_cmpgt_epi32(_mm256_set1_epi32(bounds.highVal), v)));
+}
+
+// Eight pixels per iteration with the table lookups done by gathers.
+__attribute__((target("avx2"))) void segmentRowAvx2(const uint8_t *src, int count, const HsvRange &blue, const HsvRange &yellow,
+                                                    uint8_t *blueRow, uint8_t *yellowRow)
+{
+    const HsvTables &tables = hsvTables();
+    const ExclusiveBounds BLUE{exclusiveBounds(blue)};
+    const ExclusiveBounds YELLOW{exclusiveBounds(yellow)};
+    const __m256i BYTE = _mm256_set1_epi32(0xFF);
+    const __m256i ROUND = _mm256_set1_epi32(HSV_ROUND);
+    const __m256i ZERO = _mm256_setzero_si256();
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + 4 * i));
+        const __m256i b = _mm256_and_si256(px, BYTE);
+        const __m256i g = _mm256_and_si256(_mm256_srli_epi32(px, 8), BYTE);
+        const __m256i r = _mm256_and_si256(_mm256_srli_epi32(px, 16), BYTE);
+        const __m256i v = _mm256_max_epi32(_mm256_max_epi32(b, g), r);
+        const __m256i diff = _mm256_sub_epi32(v, _mm256_min_epi32(_mm256_min_epi32(b, g), r));
+        const __m256i vr = _mm256_cmpeq_epi32(v, r);
+        const __m256i vg = _mm256_cmpeq_epi32(v, g);
+
+        const __m256i sdiv = _mm256_i32gather_epi32(tables.sdiv, v, 4);
+        const __m256i hdiv = _mm256_i32gather_epi32(tables.hdiv, diff, 4);
+        const __m256i s = _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(diff, sdiv), ROUND), HSV_SHIFT);
+
+        const __m256i twoDiff = _mm256_add_epi32(diff, diff);
+        const __m256i hueR = _mm256_sub_epi32(g, b);
+        const __m256i hueG = _mm256_add_epi32(_mm256_sub_epi32(b, r), twoDiff);
+        const __m256i hueB = _mm256_add_epi32(_mm256_sub_epi32(r, g), _mm256_add_epi32(twoDiff, twoDiff));
+        __m256i h = _mm256_add_epi32(_mm256_and_si256(vr, hueR),
+                                     _mm256_andnot_si256(vr, _mm256_add_epi32(_mm256_and_si256(vg, hueG), _mm256_andnot_si256(vg, hueB))));
+        h = _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(h, hdiv), ROUND), HSV_SHIFT);
+        h = _mm256_add_epi32(h, _mm256_and_si256(_mm256_cmpgt_epi32(ZERO, h), _mm256_set1_epi32(HUE_RANGE)));
+
+        const int blueBits = _mm256_movemask_ps(_mm256_castsi256_ps(inRangeAvx2(h, s, v, BLUE)));
+        const int yellowBits = _mm256_movemask_ps(_mm256_castsi256_ps(inRangeAvx2(h, s, v, YELLOW)));
+        std::memcpy(blueRow + i, &tables.byteMasks[blueBits], sizeof(uint64_t));
+        std::memcpy(yellowRow + i, &tables.byteMasks[yellowBits], sizeof(uint64_t));
+    }
+    segmentRowScalar(src + 4 * i, count - i, blue, yellow, blueRow + i, yellowRow + i);
+}
+#endif
+} // namespace
+
+SimdLevel bestSimdLevel()
+{
+#ifdef CONESEGMENTATION_X86
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return SimdLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1"))
+    {
+        return SimdLevel::SSE41;
+    }
+#endif
+    return SimdLevel::SCALAR;
+}
+
+namespace
+{
+typedef void (*SegmentRowFunction)(const uint8_t *, int, const HsvRange &, const HsvRange &, uint8_t *, uint8_t *);
+
+SegmentRowFunction rowKernel(SimdLevel level)
+{
+#ifdef CONESEGMENTATION_X86
+    if (level == SimdLevel::AVX2)
+    {
+        return segmentRowAvx2;
+    }
+    if (level == SimdLevel::SSE41)
+    {
+        return segmentRowSse41;
+    }
+#else
+    (void)level;
+#endif
+    return segmentRowScalar;
+}
+} // namespace
+
+void segmentCones(const cv::Mat &bgraImage, const HsvRange &blue, const HsvRange &yellow,
+                  cv::Mat &blueMask, cv::Mat &yellowMask, SimdLevel level)
+{
+    CV_Assert(bgraImage.type() == CV_8UC4);
+    blueMask.create(bgraImage.rows, bgraImage.cols, CV_8UC1);
+    yellowMask.create(bgraImage.rows, bgraImage.cols, CV_8UC1);
+
+    const SegmentRowFunction segmentRow = rowKernel(level);
+    for (int row = 0; row < bgraImage.rows; row++)
+    {
+        segmentRow(bgraImage.ptr<uint8_t>(row), bgraImage.cols, blue, yellow, blueMask.ptr<uint8_t>(row), yellowMask.ptr<uint8_t>(row));
+    }
+}
+
+void segmentCones(const cv::Mat &bgraImage, const HsvRange &blue, const HsvRange &yellow,
+                  RunLengthMask &blueMask, RunLengthMask &yellowMask, SimdLevel level)
+{
+    CV_Assert(bgraImage.type() == CV_8UC4);
+    blueMask.reset(bgraImage.rows, bgraImage.cols);
+    yellowMask.reset(bgraImage.rows, bgraImage.cols);
+
+    const SegmentRowFunction segmentRow = rowKernel(level);
+    for (int row = 0; row < bgraImage.rows; row++)
+    {
+        segmentRow(bgraImage.ptr<uint8_t>(row), bgraImage.cols, blue, yellow, blueMask.scratchRow(), yellowMask.scratchRow());
+        blueMask.appendRow(blueMask.scratchRow());
+        yellowMask.appendRow(yellowMask.scratchRow());
+    }
+}
+
+void segmentConesOpenCV(const cv::Mat &bgraImage, const HsvRange &blue, const HsvRange &yellow,
+                        cv::Mat &blueMask, cv::Mat &yellowMask)
+{
+    cv::Mat hsvImg;
+    cv::cvtColor(bgraImage, hsvImg, CV_BGR2HSV);
+    cv::inRange(hsvImg, cv::Scalar(blue.minHue, blue.minSat, blue.minVal), cv::Scalar(blue.maxHue, blue.maxSat, blue.maxVal), blueMask);
+    cv::inRange(hsvImg, cv::Scalar(yellow.minHue, yellow.minSat, yellow.minVal), cv::Scalar(yellow.maxHue, yellow.maxSat, yellow.maxVal), yellowMask);
+}
@@ -0,0 +1,37 @@
+#ifndef CONESEGMENTATION
+#define CONESEGMENTATION
+
+#include "ConeColors.hpp"
+#include "RunLengthMask.hpp"
+
+#include <opencv2/core/core.hpp>
+
+#include <cstdint>
+
+// Instruction sets the segmentation kernel can use.
+enum class SimdLevel
+{
+    SCALAR,
+    SSE41,
+    AVX2
+};
+
+// Returns the fastest instruction set supported by the CPU we are running on.
+SimdLevel bestSimdLevel();
+
+// Converts a BGRA image to HSV and thresholds it against the blue and the yellow range in a single pass.
+// Both masks are CV_8UC1 with 255 for pixels inside the range and are bit-identical to the result of
+// cv::cvtColor(CV_BGR2HSV) followed by one cv::inRange per colour.
+void segmentCones(const cv::Mat &bgraImage, const HsvRange &blue, const HsvRange &yellow,
+                  cv::Mat &blueMask, cv::Mat &yellowMask, SimdLevel level = bestSimdLevel());
+
+// Same as above, but emits run-length encoded masks directly. Each row is thresholded into a small
+// scratch buffer and encoded right away, so no full-size mask is ever written.
+void segmentCones(const cv::Mat &bgraImage, const HsvRange &blue, const HsvRange &yellow,
+                  RunLengthMask &blueMask, RunLengthMask &yellowMask, SimdLevel level = bestSimdLevel());
+
+// The reference implementation with three passes over the image, kept for testing and comparison.
+void segmentConesOpenCV(const cv::Mat &bgraImage, const HsvRange &blue, const HsvRange &yellow,
+                        cv::Mat &blueMask, cv::Mat &yellowMask);
+
+#endif
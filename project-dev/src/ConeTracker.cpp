@@ -0,0 +1,151 @@
+#include "ConeTracker.hpp"
+
+const size_t ConeTracker::CAPACITY;
+const int ConeTracker::CONFIRM_HITS;
+const int ConeTracker::MAX_MISSES;
+const float ConeTracker::ALPHA = 0.5f;
+const float ConeTracker::BETA = 0.2f;
+const float ConeTracker::GATE = 40.0f;
+
+ConeTracker::ConeTracker()
+    : m_tracks{}
+{
+}
+
+void ConeTracker::reset()
+{
+    for (Track &track : m_tracks)
+    {
+        track = Track{};
+    }
+}
+
+TrackedCone ConeTracker::report(const Track &track)
+{
+    const bool CONFIRMED = track.hits >= CONFIRM_HITS;
+    return TrackedCone{track.position, CONFIRMED ? track.velocity : cv::Point2f(), CONFIRMED};
+}
+
+size_t ConeTracker::assign(const ConeCandidate &candidate, bool (&assigned)[CAPACITY], bool takeOver)
+{
+    const cv::Point2f MEASURED = candidate.centroid();
+    size_t nearest = CAPACITY;
+    size_t free = CAPACITY;
+    size_t weakest = CAPACITY;
+    float nearestDistance = GATE * GATE;
+    for (size_t i = 0; i < CAPACITY; i++)
+    {
+        if (!m_tracks[i].active)
+        {
+            free = (free == CAPACITY) ? i : free;
+            continue;
+        }
+        if (assigned[i])
+        {
+            continue;
+        }
+        weakest = (weakest == CAPACITY || m_tracks[i].hits < m_tracks[weakest].hits) ? i : weakest;
+        const float DX = MEASURED.x - m_tracks[i].position.x;
+        const float DY = MEASURED.y - m_tracks[i].position.y;
+        const float DISTANCE = DX * DX + DY * DY;
+        if (DISTANCE < nearestDistance)
+        {
+            nearest = i;
+            nearestDistance = DISTANCE;
+        }
+    }
+
+    if (nearest != CAPACITY)
+    {
+        Track &track = m_tracks[nearest];
+        const float RESIDUAL_X = MEASURED.x - track.position.x;
+        const float RESIDUAL_Y = MEASURED.y - track.position.y;
+        track.position.x += ALPHA * RESIDUAL_X;
+        track.position.y += ALPHA * RESIDUAL_Y;
+        track.velocity.x += BETA * RESIDUAL_X;
+        track.velocity.y += BETA * RESIDUAL_Y;
+        track.hits++;
+        track.misses = 0;
+    }
+    else if (free != CAPACITY || (takeOver && weakest != CAPACITY))
+    {
+        nearest = (free != CAPACITY) ? free : weakest;
+        m_tracks[nearest] = Track{MEASURED, cv::Point2f(), 1, 0, true};
+    }
+    else
+    {
+        return CAPACITY;
+    }
+    assigned[nearest] = true;
+    return nearest;
+}
+
+TrackedCone ConeTracker::update(const ConeCandidates &candidates, ConeSelection selection)
+{
+    const ConeCandidate *const SELECTED = candidates.empty() ? nullptr : &candidates.selected(selection);
+    bool assigned[CAPACITY] = {};
+    for (Track &track : m_tracks)
+    {
+        track.position.x += track.velocity.x;
+        track.position.y += track.velocity.y;
+    }
+
+    // The selected candidate is assigned first and always gets a track, so the cone steered for is
+    // reported even if it is not among the CAPACITY largest or all tracks follow other blobs.
+    const Track *selected = nullptr;
+    if (SELECTED != nullptr)
+    {
+        selected = &m_tracks[assign(*SELECTED, assigned, true)];
+    }
+    for (const ConeCandidate &candidate : candidates)
+    {
+        if (&candidate != SELECTED)
+        {
+            assign(candidate, assigned, false);
+        }
+    }
+
+    const Track *coasting = nullptr;
+    for (size_t i = 0; i < CAPACITY; i++)
+    {
+        Track &track = m_tracks[i];
+        if (!track.active || assigned[i])
+        {
+            continue;
+        }
+        if (++track.misses > MAX_MISSES)
+        {
+            track = Track{};
+        }
+        else if (track.hits >= CONFIRM_HITS && (coasting == nullptr || track.hits > coasting->hits))
+        {
+            coasting = &track;
+        }
+    }
+
+    if (selected != nullptr)
+    {
+        return report(*selected);
+    }
+    if (coasting != nullptr)
+    {
+        return report(*coasting);
+    }
+    return TrackedCone{cv::Point2f(), cv::Point2f(), false};
+}
+
+FrameConeTracker::FrameConeTracker(ConeSelection selection)
+    : m_blue{}, m_yellow{}, m_selection{selection}
+{
+}
+
+void FrameConeTracker::track(Frame &frame)
+{
+    const TrackedCone BLUE = m_blue.update(frame.blueCandidates, m_selection);
+    const TrackedCone YELLOW = m_yellow.update(frame.yellowCandidates, m_selection);
+    frame.blueCone = BLUE.position;
+    frame.yellowCone = YELLOW.position;
+    frame.blueVelocity = BLUE.velocity;
+    frame.yellowVelocity = YELLOW.velocity;
+    frame.tracked = true;
+}
@@ -0,0 +1,80 @@
+#ifndef CONETRACKER
+#define CONETRACKER
+
+#include "BlobExtractor.hpp"
+#include "Frame.hpp"
+
+#include <opencv2/core/core.hpp>
+
+#include <cstddef>
+
+// The cone a tracker reports for a frame.
+struct TrackedCone
+{
+    cv::Point2f position; // (0, 0) if there is no cone, as for the detected cones
+    cv::Point2f velocity; // pixels per frame, (0, 0) until the track is confirmed
+    bool confirmed;       // seen in CONFIRM_HITS frames, so the velocity is meaningful
+};
+
+// Follows the cones of one colour across consecutive frames with an alpha-beta filter per track, so a
+// single noisy frame moves a cone by only a fraction of the deviation and does not reverse its velocity.
+//
+// Every frame the tracks are predicted one frame ahead and the candidates, the selected one first and then
+// largest first, are assigned to the nearest free track within the gate. Candidates without a track start
+// one in a free slot, and the selected one takes over a track if there is none; tracks without a
+// candidate coast on their prediction for up to MAX_MISSES frames. The tracks are a fixed array, so an
+// update is O(number of blobs) and does not allocate.
+//
+// The reported cone is the track of the selected candidate; without candidates it is the coasting
+// confirmed track seen most often.
+class ConeTracker
+{
+public:
+    static const size_t CAPACITY = 4;
+    static const int CONFIRM_HITS = 3;
+    static const int MAX_MISSES = 3;
+    static const float ALPHA;
+    static const float BETA;
+    static const float GATE; // pixels
+
+private:
+    struct Track
+    {
+        cv::Point2f position;
+        cv::Point2f velocity;
+        int hits;
+        int misses;
+        bool active;
+    };
+
+    Track m_tracks[CAPACITY];
+
+    static TrackedCone report(const Track &track);
+    // Updates the nearest unassigned track within the gate with the candidate, or starts a track in a free
+    // slot; with takeOver, in the unassigned track seen least often when there is no free slot. Returns
+    // the track, CAPACITY if the candidate got none.
+    size_t assign(const ConeCandidate &candidate, bool (&assigned)[CAPACITY], bool takeOver);
+
+public:
+    ConeTracker();
+
+    TrackedCone update(const ConeCandidates &candidates, ConeSelection selection = ConeSelection::LARGEST);
+    void reset();
+};
+
+// Tracks the cones of both colours and replaces the detected cones of the frame with the tracked ones.
+class FrameConeTracker
+{
+private:
+    ConeTracker m_blue;
+    ConeTracker m_yellow;
+    ConeSelection m_selection;
+
+public:
+    explicit FrameConeTracker(ConeSelection selection = ConeSelection::LARGEST);
+
+    // Frames must be passed in order.
+    void track(Frame &frame);
+};
+
+#endif
@@ -0,0 +1,36 @@
+#include "Evaluation.hpp"
+#include "RecordingSource.hpp"
+
+#include <chrono>
+
+EvaluationResult evaluateRecording(const std::string &fileName, const EvaluationSettings &settings)
+{
+    const auto START = std::chrono::steady_clock::now();
+    EvaluationResult result;
+    result.recording = fileName;
+
+    FrameAcquisition acquisition{settings.width, settings.height, settings.roi, false};
+    RecordingSource recording{fileName, acquisition};
+    if (!H264Decoder::available() || !recording.valid())
+    {
+        return result;
+    }
+    result.valid = true;
+
+    FrameProcessor processor{acquisition.roi(), settings.processing, makeSteeringModel(settings.processing, settings.width)};
+    Frame frame;
+    while (recording.next(frame))
+    {
+        processor.segment(frame);
+        processor.detect(frame);
+        processor.estimate(frame);
+        result.frames++;
+        if (isCorrectAngle(frame.calculatedAngle, frame.groundSteering))
+        {
+            result.correctAngles++;
+        }
+    }
+    result.skippedFrames = recording.skippedFrames();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - START).count();
+    return result;
+}
@@ -0,0 +1,42 @@
+#ifndef EVALUATION
+#define EVALUATION
+
+#include "FrameAcquisition.hpp"
+#include "FrameProcessor.hpp"
+
+#include <cstdint>
+#include <string>
+
+// A calculated angle counts as correct when it lies strictly within this distance of the ground truth.
+const double ANGLE_TOLERANCE = 0.05;
+
+inline bool isCorrectAngle(double calculatedAngle, double groundSteering)
+{
+    return calculatedAngle < groundSteering + ANGLE_TOLERANCE && calculatedAngle > groundSteering - ANGLE_TOLERANCE;
+}
+
+// How the frames of a recording are processed.
+struct EvaluationSettings
+{
+    uint32_t width;
+    uint32_t height;
+    RegionOfInterest roi;
+    ProcessingSettings processing;
+};
+
+struct EvaluationResult
+{
+    std::string recording{};
+    bool valid{false};
+    uint64_t frames{0};
+    uint64_t correctAngles{0};
+    uint64_t skippedFrames{0};
+    double seconds{0.0};
+
+    double accuracy() const { return frames > 0 ? static_cast<double>(correctAngles) / static_cast<double>(frames) : 0.0; }
+};
+
+// Runs the frames of a recording through the stages of a FrameProcessor on the calling thread and counts the angles within ANGLE_TOLERANCE of the ground truth.
+EvaluationResult evaluateRecording(const std::string &fileName, const EvaluationSettings &settings);
+
+#endif
@@ -0,0 +1,44 @@
+# You may redistribute this program and/or modify it under the terms of
+# the GNU General Public License as published by the Free Software Foundation,
+# either version 3 of the License, or (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+if(NOT OPENH264_FOUND)
+
+    find_path(OPENH264_INCLUDE_DIR
+        NAMES
+            wels/codec_api.h
+        PATHS
+            ${OPENH264DIR}/include/
+            /usr/local/include/
+            /usr/include/
+    )
+
+    find_library(OPENH264_LIBRARIES openh264
+        PATHS
+            ${OPENH264DIR}/lib/
+            /usr/local/lib/
+            /usr/lib/
+    )
+
+    if (OPENH264_INCLUDE_DIR AND OPENH264_LIBRARIES)
+        set (OPENH264_FOUND TRUE)
+    endif (OPENH264_INCLUDE_DIR AND OPENH264_LIBRARIES)
+
+    if (OPENH264_FOUND)
+        message(STATUS "Found openh264: ${OPENH264_INCLUDE_DIR}, ${OPENH264_LIBRARIES}")
+    else (OPENH264_FOUND)
+        if (OpenH264_FIND_REQUIRED)
+            message (FATAL_ERROR "Could not find openh264, try to setup OPENH264DIR accordingly")
+        endif (OpenH264_FIND_REQUIRED)
+        message(STATUS "openh264 not found; offline evaluation of recordings (--rec) is disabled.")
+    endif (OPENH264_FOUND)
+
+endif (NOT OPENH264_FOUND)
@@ -0,0 +1,40 @@
+#ifndef FRAME
+#define FRAME
+
+#include "BlobExtractor.hpp"
+#include "RunLengthMask.hpp"
+
+#include <opencv2/core/core.hpp>
+
+#include <cstdint>
+
+// Everything that is known about one camera frame while it travels through the processing stages.
+// Frames are reused, so their buffers are only allocated for the first frame.
+struct Frame
+{
+    int64_t sampleTimeStamp{0}; // microseconds, from the producer of the shared memory
+    float groundSteering{0.0f}; // latest GroundSteeringRequest when the frame was acquired
+    bool degraded{false};       // processed at reduced quality to catch up after frames were lost
+
+    cv::Mat image{}; // the complete frame, only when it is displayed
+    cv::Mat band{};  // region of interest, possibly a view into image
+    // Part of the band that is searched for cones, all of it when empty. The masks cover the window; the
+    // candidates and cones are relative to the band either way.
+    cv::Rect window{};
+
+    RunLengthMask blueMask{};
+    RunLengthMask yellowMask{};
+    ConeCandidates blueCandidates{};
+    ConeCandidates yellowCandidates{};
+    cv::Point2f blueCone{};
+    cv::Point2f yellowCone{};
+    // With cone tracking the cones above are the tracked ones and these their velocities in pixels per
+    // frame, (0, 0) while a track is not confirmed.
+    bool tracked{false};
+    cv::Point2f blueVelocity{};
+    cv::Point2f yellowVelocity{};
+
+    double calculatedAngle{0.0};
+};
+
+#endif
@@ -0,0 +1,65 @@
+#include "FrameAcquisition.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+bool RegionOfInterest::validFor(uint32_t frameWidth, uint32_t frameHeight) const
+{
+    return 0 <= top && top < bottom && bottom <= static_cast<int>(frameHeight) &&
+           0 <= left && left < right && right <= static_cast<int>(frameWidth);
+}
+
+RegionOfInterest RegionOfInterest::clampedTo(uint32_t frameWidth, uint32_t frameHeight) const
+{
+    RegionOfInterest clamped{*this};
+    clamped.top = std::max(0, std::min(top, static_cast<int>(frameHeight)));
+    clamped.bottom = std::max(clamped.top, std::min(bottom, static_cast<int>(frameHeight)));
+    clamped.left = std::max(0, std::min(left, static_cast<int>(frameWidth)));
+    clamped.right = std::max(clamped.left, std::min(right, static_cast<int>(frameWidth)));
+    return clamped;
+}
+
+RegionOfInterest defaultRegionOfInterest(uint32_t frameWidth, uint32_t frameHeight)
+{
+    const int64_t HEIGHT = static_cast<int64_t>(frameHeight);
+    return RegionOfInterest{static_cast<int>((DEFAULT_ROI_TOP * HEIGHT + REFERENCE_FRAME_HEIGHT / 2) / REFERENCE_FRAME_HEIGHT),
+                            static_cast<int>((DEFAULT_ROI_BOTTOM * HEIGHT + REFERENCE_FRAME_HEIGHT / 2) / REFERENCE_FRAME_HEIGHT),
+                            0, static_cast<int>(frameWidth)};
+}
+
+FrameAcquisition::FrameAcquisition(uint32_t width, uint32_t height, const RegionOfInterest &roi, bool copyFullFrame)
+    : m_width{width}, m_height{height}, m_roi{roi.clampedTo(width, height)}, m_copyFullFrame{copyFullFrame}
+{
+}
+
+void FrameAcquisition::copyFrom(const char *sharedMemoryData, Frame &frame) const
+{
+    const size_t BYTES_PER_PIXEL = 4;
+    const size_t FRAME_STEP = m_width * BYTES_PER_PIXEL;
+    if (m_copyFullFrame)
+    {
+        if (frame.image.empty())
+        {
+            frame.image.create(static_cast<int>(m_height), static_cast<int>(m_width), CV_8UC4);
+            frame.band = frame.image(cv::Range(m_roi.top, m_roi.bottom), cv::Range(m_roi.left, m_roi.right));
+        }
+        std::memcpy(frame.image.data, sharedMemoryData, FRAME_STEP * m_height);
+        return;
+    }
+
+    frame.band.create(m_roi.height(), m_roi.width(), CV_8UC4);
+    const char *src = sharedMemoryData + m_roi.top * FRAME_STEP + m_roi.left * BYTES_PER_PIXEL;
+    const size_t ROW_BYTES = static_cast<size_t>(m_roi.width()) * BYTES_PER_PIXEL;
+    if (ROW_BYTES == FRAME_STEP && frame.band.isContinuous())
+    {
+        // The band spans whole rows, so it is one contiguous block in the shared memory.
+        std::memcpy(frame.band.data, src, ROW_BYTES * static_cast<size_t>(m_roi.height()));
+    }
+    else
+    {
+        for (int row = 0; row < m_roi.height(); row++)
+        {
+            std::memcpy(frame.band.ptr(row), src + row * FRAME_STEP, ROW_BYTES);
+        }
+    }
+}
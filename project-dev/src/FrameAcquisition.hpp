@@ -0,0 +1,57 @@
+#ifndef FRAMEACQUISITION
+#define FRAMEACQUISITION
+
+#include "Frame.hpp"
+
+#include <opencv2/core/core.hpp>
+
+#include <cstdint>
+
+// Rectangular band of the camera frame that is processed: rows [top, bottom) and columns [left, right).
+struct RegionOfInterest
+{
+    int top;
+    int bottom;
+    int left;
+    int right;
+
+    int width() const { return right - left; }
+    int height() const { return bottom - top; }
+    // Whether the region is not empty and lies inside a frame of the given size.
+    bool validFor(uint32_t frameWidth, uint32_t frameHeight) const;
+    // Shrinks the region so that it lies inside a frame of the given size.
+    RegionOfInterest clampedTo(uint32_t frameWidth, uint32_t frameHeight) const;
+};
+
+// Band in which the cones are searched by default, for frames REFERENCE_FRAME_HEIGHT rows high
+const int REFERENCE_FRAME_HEIGHT = 480;
+const int DEFAULT_ROI_TOP = 310;
+const int DEFAULT_ROI_BOTTOM = 360;
+
+// The default band scaled to the height of the frame, over its full width.
+RegionOfInterest defaultRegionOfInterest(uint32_t frameWidth, uint32_t frameHeight);
+
+// Copies frames out of the shared memory area. By default only the region of interest is copied
+// so that the producer (h264 decoder) is blocked as short as possible while we hold the lock.
+class FrameAcquisition
+{
+private:
+    uint32_t m_width;
+    uint32_t m_height;
+    RegionOfInterest m_roi;
+    bool m_copyFullFrame;
+
+public:
+    FrameAcquisition(uint32_t width, uint32_t height, const RegionOfInterest &roi, bool copyFullFrame);
+
+    // Must be called while the shared memory is locked. Fills frame.band and, when the full frame is
+    // copied, frame.image (frame.band is then a view into it). The buffers are only allocated once per frame.
+    void copyFrom(const char *sharedMemoryData, Frame &frame) const;
+
+    uint32_t width() const { return m_width; }
+    uint32_t height() const { return m_height; }
+    const RegionOfInterest &roi() const { return m_roi; }
+    bool copiesFullFrame() const { return m_copyFullFrame; }
+};
+
+#endif
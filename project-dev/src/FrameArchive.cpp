@@ -0,0 +1,123 @@
+#include "FrameArchive.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+const char MAGIC[8] = {'G', '1', '5', 'F', 'R', 'A', 'M', 'E'};
+const uint32_t VERSION = 1;
+const size_t ALIGNMENT = 64;
+const size_t BYTES_PER_PIXEL = 4;
+
+static_assert(sizeof(FrameArchiveHeader) == ALIGNMENT, "the header keeps the slots aligned");
+static_assert(sizeof(FrameArchiveEntry) == ALIGNMENT, "the entry keeps the pixels aligned");
+} // namespace
+
+FrameArchiveWriter::FrameArchiveWriter(const std::string &fileName, uint32_t frameWidth, uint32_t frameHeight, const RegionOfInterest &region)
+    : m_file{fileName, std::ios::binary | std::ios::trunc}, m_region{region.clampedTo(frameWidth, frameHeight)},
+      m_pixelBytes{static_cast<size_t>(m_region.width()) * static_cast<size_t>(m_region.height()) * BYTES_PER_PIXEL},
+      m_paddingBytes{(ALIGNMENT - m_pixelBytes % ALIGNMENT) % ALIGNMENT}, m_frames{0}
+{
+    if (m_file.is_open())
+    {
+        FrameArchiveHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.frameWidth = frameWidth;
+        header.frameHeight = frameHeight;
+        header.top = m_region.top;
+        header.bottom = m_region.bottom;
+        header.left = m_region.left;
+        header.right = m_region.right;
+        header.slotSize = static_cast<uint32_t>(sizeof(FrameArchiveEntry) + m_pixelBytes + m_paddingBytes);
+        m_file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    }
+}
+
+void FrameArchiveWriter::append(const cv::Mat &pixels, int64_t sampleTimeStamp, float groundSteering)
+{
+    CV_Assert(pixels.type() == CV_8UC4 && pixels.cols == m_region.width() && pixels.rows == m_region.height());
+    FrameArchiveEntry entry;
+    std::memset(&entry, 0, sizeof(entry));
+    entry.sampleTimeStamp = sampleTimeStamp;
+    entry.groundSteering = groundSteering;
+    m_file.write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+
+    const size_t ROW_BYTES = static_cast<size_t>(pixels.cols) * BYTES_PER_PIXEL;
+    if (pixels.isContinuous())
+    {
+        m_file.write(reinterpret_cast<const char *>(pixels.data), static_cast<std::streamsize>(m_pixelBytes));
+    }
+    else
+    {
+        for (int row = 0; row < pixels.rows; row++)
+        {
+            m_file.write(reinterpret_cast<const char *>(pixels.ptr(row)), static_cast<std::streamsize>(ROW_BYTES));
+        }
+    }
+    const char PADDING[ALIGNMENT]{};
+    m_file.write(PADDING, static_cast<std::streamsize>(m_paddingBytes));
+    m_frames++;
+}
+
+FrameArchive::FrameArchive(const std::string &fileName)
+    : m_data{nullptr}, m_size{0}, m_header(), m_frames{0}
+{
+    const int FD = open(fileName.c_str(), O_RDONLY);
+    if (FD < 0)
+    {
+        return;
+    }
+    struct stat status;
+    if (0 == fstat(FD, &status) && static_cast<size_t>(status.st_size) >= sizeof(FrameArchiveHeader))
+    {
+        m_size = static_cast<size_t>(status.st_size);
+        // Private and writable so that the frames can be drawn on; MAP_POPULATE reads the file right away
+        // instead of faulting the pages in while the frames are processed.
+        void *data = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_POPULATE, FD, 0);
+        if (MAP_FAILED != data)
+        {
+            std::memcpy(&m_header, data, sizeof(m_header));
+            const RegionOfInterest REGION = region();
+            const size_t PIXEL_BYTES = static_cast<size_t>(REGION.width()) * static_cast<size_t>(REGION.height()) * BYTES_PER_PIXEL;
+            if (0 == std::memcmp(m_header.magic, MAGIC, sizeof(MAGIC)) && VERSION == m_header.version &&
+                REGION.width() > 0 && REGION.height() > 0 && m_header.slotSize >= sizeof(FrameArchiveEntry) + PIXEL_BYTES)
+            {
+                m_data = static_cast<uint8_t *>(data);
+                m_frames = (m_size - sizeof(FrameArchiveHeader)) / m_header.slotSize;
+            }
+            else
+            {
+                munmap(data, m_size);
+            }
+        }
+    }
+    close(FD);
+}
+
+FrameArchive::~FrameArchive()
+{
+    if (nullptr != m_data)
+    {
+        munmap(m_data, m_size);
+    }
+}
+
+void FrameArchive::read(size_t index, const RegionOfInterest &roi, Frame &frame) const
+{
+    const RegionOfInterest REGION = region();
+    CV_Assert(index < m_frames && roi.top >= REGION.top && roi.bottom <= REGION.bottom && roi.left >= REGION.left && roi.right <= REGION.right);
+    uint8_t *slot = m_data + sizeof(FrameArchiveHeader) + index * m_header.slotSize;
+    const FrameArchiveEntry *entry = reinterpret_cast<const FrameArchiveEntry *>(slot);
+    frame.sampleTimeStamp = entry->sampleTimeStamp;
+    frame.groundSteering = entry->groundSteering;
+    frame.image = cv::Mat(REGION.height(), REGION.width(), CV_8UC4, slot + sizeof(FrameArchiveEntry));
+    frame.band = frame.image(cv::Range(roi.top - REGION.top, roi.bottom - REGION.top), cv::Range(roi.left - REGION.left, roi.right - REGION.left));
+}
@@ -0,0 +1,90 @@
+#ifndef FRAMEARCHIVE
+#define FRAMEARCHIVE
+
+#include "Frame.hpp"
+#include "FrameAcquisition.hpp"
+
+#include <opencv2/core/core.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+// File layout of a frame archive: a header followed by one slot per frame. A slot holds the entry of the
+// frame followed by the BGRA pixels of the stored region (the whole frame or only the band). All slots
+// have the same size, so frame i starts at HEADER_SIZE + i * slotSize and the archive needs no separate
+// index; a recording that was interrupted loses at most the last, incomplete frame. The pixels are
+// 64-byte aligned so that they can be processed in place from a memory mapping.
+struct FrameArchiveHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t frameWidth;
+    uint32_t frameHeight;
+    int32_t top; // stored region of the frame
+    int32_t bottom;
+    int32_t left;
+    int32_t right;
+    uint32_t slotSize;
+    char reserved[24];
+};
+
+struct FrameArchiveEntry
+{
+    int64_t sampleTimeStamp; // microseconds
+    float groundSteering;
+    uint32_t reserved[13];
+};
+
+// Appends frames to an archive, e.g. as they arrive from the shared memory.
+class FrameArchiveWriter
+{
+private:
+    std::ofstream m_file;
+    RegionOfInterest m_region;
+    size_t m_pixelBytes;
+    size_t m_paddingBytes;
+    uint64_t m_frames;
+
+public:
+    // Stores the given region of frames of frameWidth x frameHeight pixels.
+    FrameArchiveWriter(const std::string &fileName, uint32_t frameWidth, uint32_t frameHeight, const RegionOfInterest &region);
+
+    bool isOpen() const { return m_file.is_open(); }
+    const RegionOfInterest &region() const { return m_region; }
+    uint64_t frames() const { return m_frames; }
+
+    // pixels is the stored region of the frame as CV_8UC4.
+    void append(const cv::Mat &pixels, int64_t sampleTimeStamp, float groundSteering);
+};
+
+// Read access to an archive through a private memory mapping; frames are handed out as views into the
+// mapping, so replaying them copies nothing and does no I/O once the file is mapped.
+class FrameArchive
+{
+private:
+    uint8_t *m_data;
+    size_t m_size;
+    FrameArchiveHeader m_header;
+    size_t m_frames;
+
+public:
+    explicit FrameArchive(const std::string &fileName);
+    ~FrameArchive();
+    FrameArchive(const FrameArchive &) = delete;
+    FrameArchive &operator=(const FrameArchive &) = delete;
+
+    // False if the file is missing or not a frame archive.
+    bool valid() const { return nullptr != m_data; }
+    size_t frameCount() const { return m_frames; }
+    uint32_t frameWidth() const { return m_header.frameWidth; }
+    uint32_t frameHeight() const { return m_header.frameHeight; }
+    RegionOfInterest region() const { return RegionOfInterest{m_header.top, m_header.bottom, m_header.left, m_header.right}; }
+
+    // Points frame.image at the stored pixels of frame index and frame.band at roi (in frame coordinates),
+    // which must lie inside region(). Writing to the views only changes the private copy of the mapping.
+    void read(size_t index, const RegionOfInterest &roi, Frame &frame) const;
+};
+
+#endif
@@ -0,0 +1,6 @@
+#include "FrameArena.hpp"
+
+FrameArena::FrameArena(size_t capacity)
+    : m_block{new unsigned char[capacity > 0 ? capacity : 1]}, m_capacity{capacity}, m_used{0}, m_highWater{0}
+{
+}
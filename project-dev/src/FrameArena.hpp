@@ -0,0 +1,52 @@
+#ifndef FRAMEARENA
+#define FRAMEARENA
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+// Bump allocator for the scratch data of one frame. Allocations are carved out of a single block that is
+// allocated up front and released all at once by reset() when the frame is done, so allocating is a
+// pointer increment and the detection never waits for malloc, whatever the number of blobs. Only for
+// trivially destructible types; nothing is constructed or destroyed.
+class FrameArena
+{
+private:
+    std::unique_ptr<unsigned char[]> m_block;
+    size_t m_capacity;
+    size_t m_used;
+    size_t m_highWater;
+
+public:
+    explicit FrameArena(size_t capacity);
+
+    // Uninitialised storage for count objects; throws std::bad_alloc when the block is exhausted.
+    template <typename T>
+    T *allocate(size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "FrameArena does not call destructors");
+        const size_t OFFSET = (m_used + alignof(T) - 1) / alignof(T) * alignof(T);
+        if (OFFSET > m_capacity || count > (m_capacity - OFFSET) / sizeof(T))
+        {
+            throw std::bad_alloc();
+        }
+        m_used = OFFSET + count * sizeof(T);
+        if (m_used > m_highWater)
+        {
+            m_highWater = m_used;
+        }
+        return reinterpret_cast<T *>(m_block.get() + OFFSET);
+    }
+
+    // Releases everything allocated since the last reset.
+    void reset() { m_used = 0; }
+
+    size_t capacity() const { return m_capacity; }
+    size_t used() const { return m_used; }
+    // Most bytes that were in use at the same time.
+    size_t highWater() const { return m_highWater; }
+};
+
+#endif
@@ -0,0 +1,98 @@
+#include "FramePipeline.hpp"
+#include "SpscQueue.hpp"
+
+#include <memory>
+#include <thread>
+
+namespace
+{
+// Marks the end of the stream in the queues of frame slot indices.
+const int END_OF_STREAM = -1;
+} // namespace
+
+FramePipeline::FramePipeline(Source source, std::vector<Stage> stages, size_t frameSlots)
+    : FramePipeline(std::move(source), std::move(stages), FrameWorkspace{frameSlots})
+{
+}
+
+FramePipeline::FramePipeline(Source source, std::vector<Stage> stages, FrameWorkspace frames)
+    : m_source{std::move(source)}, m_stages{std::move(stages)}, m_frames{std::move(frames)}
+{
+}
+
+void FramePipeline::run(bool threaded)
+{
+    if (threaded && !m_stages.empty())
+    {
+        runThreaded();
+    }
+    else
+    {
+        runSerial();
+    }
+}
+
+void FramePipeline::runSerial()
+{
+    Frame &frame = m_frames[0];
+    while (m_source(frame))
+    {
+        for (const Stage &stage : m_stages)
+        {
+            stage(frame);
+        }
+    }
+}
+
+void FramePipeline::runThreaded()
+{
+    // queues[i] feeds stage i; the last queue returns processed slots to the source.
+    const size_t STAGES = m_stages.size();
+    std::vector<std::unique_ptr<SpscQueue<int>>> queues;
+    for (size_t i = 0; i <= STAGES; i++)
+    {
+        queues.emplace_back(new SpscQueue<int>{m_frames.size() + 1});
+    }
+    for (size_t slot = 0; slot < m_frames.size(); slot++)
+    {
+        queues[STAGES]->push(static_cast<int>(slot));
+    }
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < STAGES; i++)
+    {
+        threads.emplace_back([this, i, &queues]() {
+            SpscQueue<int> &input = *queues[i];
+            SpscQueue<int> &output = *queues[i + 1];
+            for (;;)
+            {
+                const int slot = input.pop();
+                if (slot != END_OF_STREAM)
+                {
+                    m_stages[i](m_frames[static_cast<size_t>(slot)]);
+                }
+                output.push(slot);
+                if (slot == END_OF_STREAM)
+                {
+                    break;
+                }
+            }
+        });
+    }
+
+    // Only wait for the next frame once there is a free slot to copy it into.
+    for (;;)
+    {
+        const int slot = queues[STAGES]->pop();
+        if (!m_source(m_frames[static_cast<size_t>(slot)]))
+        {
+            queues.front()->push(END_OF_STREAM);
+            break;
+        }
+        queues.front()->push(slot);
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef FRAMEPIPELINE
+#define FRAMEPIPELINE
+
+#include "Frame.hpp"
+#include "FrameWorkspace.hpp"
+
+#include <functional>
+#include <vector>
+
+// Runs frames through a source (e.g. acquisition from the shared memory) followed by a chain of stages.
+// Serially, every frame passes all stages before the next one is acquired. Threaded, the source runs on
+// the calling thread and every stage on its own thread; the stages are connected by lock-free
+// single-producer/single-consumer queues of frame slots, so acquiring frame N+1 overlaps with processing
+// frame N while every stage still sees the frames in acquisition order.
+class FramePipeline
+{
+public:
+    // Fills the next frame; returning false ends the stream.
+    typedef std::function<bool(Frame &)> Source;
+    typedef std::function<void(Frame &)> Stage;
+
+private:
+    Source m_source;
+    std::vector<Stage> m_stages;
+    FrameWorkspace m_frames;
+
+    void runSerial();
+    void runThreaded();
+
+public:
+    // frameSlots bounds the number of frames in flight when threaded.
+    FramePipeline(Source source, std::vector<Stage> stages, size_t frameSlots);
+    // Runs the frames of a preallocated workspace; its size bounds the frames in flight.
+    FramePipeline(Source source, std::vector<Stage> stages, FrameWorkspace frames);
+
+    // Returns when the source ended and all acquired frames passed every stage.
+    void run(bool threaded);
+};
+
+#endif
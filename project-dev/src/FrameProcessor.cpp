@@ -0,0 +1,47 @@
+#include "FrameProcessor.hpp"
+#include "SteeringEstimator.hpp"
+
+#include <utility>
+
+std::unique_ptr<SteeringModel> makeSteeringModel(const ProcessingSettings &settings, uint32_t frameWidth)
+{
+    if (settings.polynomialModel)
+    {
+        return std::unique_ptr<SteeringModel>{new PolynomialSteeringModel{settings.modelParameters}};
+    }
+    return std::unique_ptr<SteeringModel>{new SteeringEstimator{scaledSteeringThresholds(DEFAULT_STEERING_THRESHOLDS, frameWidth), settings.rules}};
+}
+
+FrameProcessor::FrameProcessor(const RegionOfInterest &roi, const ProcessingSettings &settings, std::unique_ptr<SteeringModel> steeringModel)
+    : m_detector{roi.width(), roi.height(), settings.exactSegmentation, settings.lutBits, settings.drawDebug, settings.detectionThreads, settings.coneSelection},
+      m_tracker{settings.coneSelection}, m_regionController{roi.width(), roi.height()}, m_steeringModel{std::move(steeringModel)},
+      m_tracking{settings.tracking}, m_adaptiveRegion{settings.adaptiveRegion}
+{
+}
+
+void FrameProcessor::segment(Frame &frame)
+{
+    if (m_adaptiveRegion)
+    {
+        frame.window = m_regionController.next();
+    }
+    m_detector.segment(frame);
+}
+
+void FrameProcessor::detect(Frame &frame)
+{
+    m_detector.detect(frame);
+}
+
+void FrameProcessor::estimate(Frame &frame)
+{
+    if (m_tracking)
+    {
+        m_tracker.track(frame);
+    }
+    if (m_adaptiveRegion)
+    {
+        m_regionController.update(frame);
+    }
+    frame.calculatedAngle = m_steeringModel->estimate(makeSteeringFeatures(frame));
+}
@@ -0,0 +1,61 @@
+#ifndef FRAMEPROCESSOR
+#define FRAMEPROCESSOR
+
+#include "ConeDetector.hpp"
+#include "ConeTracker.hpp"
+#include "FrameAcquisition.hpp"
+#include "PolynomialSteeringModel.hpp"
+#include "RegionController.hpp"
+#include "SteeringModel.hpp"
+#include "SteeringRules.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// How the acquired frames are turned into steering angles.
+struct ProcessingSettings
+{
+    bool exactSegmentation;
+    int lutBits;
+    size_t detectionThreads;
+    ConeSelection coneSelection;
+    bool tracking;       // steer with the cones tracked across frames
+    bool adaptiveRegion; // search only the neighbourhood of the cones of the last frame, see RegionController
+    bool drawDebug;      // draw the masks and cones onto the band
+    SteeringRules rules;  // of the SteeringEstimator, unless polynomialModel
+    bool polynomialModel; // steer with a PolynomialSteeringModel of modelParameters
+    PolynomialSteeringParameters modelParameters;
+};
+
+// The steering model the settings ask for, with the thresholds of the rules scaled to frameWidth.
+std::unique_ptr<SteeringModel> makeSteeringModel(const ProcessingSettings &settings, uint32_t frameWidth);
+
+// The stages every acquired frame passes, shared by template-opencv and the batch evaluator so that an
+// evaluation measures the steering that ships: segment() classifies the pixels of the band (or of the
+// window the RegionController chose), detect() finds the cone candidates and estimate() tracks the cones,
+// adapts the window and steers. Each stage must see the frames in order, but the stages may run on
+// different threads.
+class FrameProcessor
+{
+private:
+    ConeDetector m_detector;
+    FrameConeTracker m_tracker;
+    RegionController m_regionController;
+    std::unique_ptr<SteeringModel> m_steeringModel;
+    bool m_tracking;
+    bool m_adaptiveRegion;
+
+public:
+    FrameProcessor(const RegionOfInterest &roi, const ProcessingSettings &settings, std::unique_ptr<SteeringModel> steeringModel);
+    FrameProcessor(const FrameProcessor &) = delete;
+    FrameProcessor &operator=(const FrameProcessor &) = delete;
+
+    const ConeDetector &detector() const { return m_detector; }
+
+    void segment(Frame &frame);
+    void detect(Frame &frame);
+    void estimate(Frame &frame);
+};
+
+#endif
@@ -0,0 +1,57 @@
+#include "FrameTiming.hpp"
+
+#include <algorithm>
+
+const size_t FrameTiming::LEARNING_GAPS;
+
+FrameTiming::FrameTiming(int64_t period)
+    : m_period{period}, m_learnPeriod{period <= 0}, m_previous{0}, m_hasPrevious{false}, m_gaps{}, m_gapCount{0}
+{
+}
+
+void FrameTiming::learn(int64_t gap)
+{
+    if (m_gapCount == LEARNING_GAPS)
+    {
+        return;
+    }
+    m_gaps[m_gapCount++] = gap;
+    // The median of the gaps so far, the upper one of an even number.
+    std::array<int64_t, LEARNING_GAPS> sorted = m_gaps;
+    const auto MEDIAN = sorted.begin() + static_cast<std::ptrdiff_t>(m_gapCount / 2);
+    std::nth_element(sorted.begin(), MEDIAN, sorted.begin() + static_cast<std::ptrdiff_t>(m_gapCount));
+    m_period = *MEDIAN;
+}
+
+int64_t FrameTiming::next(int64_t sampleTimeStamp)
+{
+    if (!m_hasPrevious)
+    {
+        m_previous = sampleTimeStamp;
+        m_hasPrevious = true;
+        return 1;
+    }
+    const int64_t GAP = sampleTimeStamp - m_previous;
+    if (GAP == 0)
+    {
+        return 0;
+    }
+    m_previous = sampleTimeStamp;
+    if (GAP < 0)
+    {
+        // The producer or the replay restarted; follow the new timestamps from this frame on.
+        if (m_learnPeriod)
+        {
+            m_period = 0;
+            m_gapCount = 0;
+        }
+        return 1;
+    }
+    if (m_learnPeriod)
+    {
+        learn(GAP);
+    }
+    // Rounded to whole periods as the producer does not publish its frames exactly on time.
+    const int64_t PERIODS = (GAP + m_period / 2) / m_period;
+    return PERIODS > 0 ? PERIODS : 1;
+}
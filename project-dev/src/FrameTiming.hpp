@@ -0,0 +1,41 @@
+#ifndef FRAMETIMING
+#define FRAMETIMING
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Follows the sample timestamps of the frames taken from the shared memory. When wait() wakes up late
+// the producer may already have written more than one frame, and after a slow frame wait() may return
+// for a frame that was already processed; both show up as gaps in the timestamp sequence.
+class FrameTiming
+{
+public:
+    // A learned period is the median of this many gaps, so neither a jittery pair of frames nor a few
+    // missed frames while learning skew it.
+    static const size_t LEARNING_GAPS = 9;
+
+private:
+    int64_t m_period;
+    bool m_learnPeriod;
+    int64_t m_previous;
+    bool m_hasPrevious;
+    std::array<int64_t, LEARNING_GAPS> m_gaps;
+    size_t m_gapCount;
+
+    void learn(int64_t gap);
+
+public:
+    // The frame period of the producer in microseconds; with 0 it is learned from the first gaps.
+    explicit FrameTiming(int64_t period = 0);
+
+    // Returns the number of frame periods since the previous frame: 1 for the next frame, more when
+    // frames were missed in between and 0 when it is the previous frame again. A timestamp before the
+    // previous one means the producer restarted: it counts as the next frame and a learned period is
+    // learned again.
+    int64_t next(int64_t sampleTimeStamp);
+
+    int64_t period() const { return m_period; }
+};
+
+#endif
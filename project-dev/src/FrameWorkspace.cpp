@@ -0,0 +1,27 @@
+#include "FrameWorkspace.hpp"
+
+FrameWorkspace::FrameWorkspace(size_t slots)
+    : m_frames(slots > 0 ? slots : 1)
+{
+}
+
+FrameWorkspace::FrameWorkspace(size_t slots, const FrameAcquisition &acquisition)
+    : FrameWorkspace(slots)
+{
+    const RegionOfInterest &ROI = acquisition.roi();
+    for (Frame &frame : m_frames)
+    {
+        // The same buffers FrameAcquisition::copyFrom() would create for the first frame.
+        if (acquisition.copiesFullFrame())
+        {
+            frame.image.create(static_cast<int>(acquisition.height()), static_cast<int>(acquisition.width()), CV_8UC4);
+            frame.band = frame.image(cv::Range(ROI.top, ROI.bottom), cv::Range(ROI.left, ROI.right));
+        }
+        else
+        {
+            frame.band.create(ROI.height(), ROI.width(), CV_8UC4);
+        }
+        frame.blueMask.reset(ROI.height(), ROI.width());
+        frame.yellowMask.reset(ROI.height(), ROI.width());
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef FRAMEWORKSPACE
+#define FRAMEWORKSPACE
+
+#include "Frame.hpp"
+#include "FrameAcquisition.hpp"
+
+#include <cstddef>
+#include <vector>
+
+// The frame slots that travel through the pipeline. Sized for an acquisition, every buffer of a frame is
+// allocated up front from the frame size and region of interest: the band, or the whole frame when it is
+// copied, and both cone masks for their worst case. The stages allocate their scratch buffers in their
+// constructors, so in steady state processing a frame does not allocate at all.
+class FrameWorkspace
+{
+private:
+    std::vector<Frame> m_frames;
+
+public:
+    // Frames whose buffers are allocated on first use.
+    explicit FrameWorkspace(size_t slots);
+    FrameWorkspace(size_t slots, const FrameAcquisition &acquisition);
+
+    size_t size() const { return m_frames.size(); }
+    Frame &operator[](size_t slot) { return m_frames[slot]; }
+};
+
+#endif
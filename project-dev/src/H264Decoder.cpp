@@ -0,0 +1,82 @@
+#include "H264Decoder.hpp"
+
+#ifdef HAVE_OPENH264
+#include <wels/codec_api.h>
+
+#include <cstring>
+#endif
+
+#ifdef HAVE_OPENH264
+H264Decoder::H264Decoder()
+    : m_decoder{nullptr}
+{
+    if (0 == WelsCreateDecoder(&m_decoder) && nullptr != m_decoder)
+    {
+        SDecodingParam decodingParam;
+        std::memset(&decodingParam, 0, sizeof(decodingParam));
+        decodingParam.eVideoBsType = VIDEO_BITSTREAM_DEFAULT;
+        if (0 != m_decoder->Initialize(&decodingParam))
+        {
+            WelsDestroyDecoder(m_decoder);
+            m_decoder = nullptr;
+        }
+    }
+}
+
+H264Decoder::~H264Decoder()
+{
+    if (nullptr != m_decoder)
+    {
+        m_decoder->Uninitialize();
+        WelsDestroyDecoder(m_decoder);
+    }
+}
+
+bool H264Decoder::available()
+{
+    return true;
+}
+
+bool H264Decoder::decode(const std::string &data, YuvPlanes &planes)
+{
+    if (nullptr == m_decoder)
+    {
+        return false;
+    }
+    unsigned char *yuv[3]{nullptr, nullptr, nullptr};
+    SBufferInfo bufferInfo;
+    std::memset(&bufferInfo, 0, sizeof(bufferInfo));
+    if (0 != m_decoder->DecodeFrame2(reinterpret_cast<const unsigned char *>(data.data()), static_cast<int>(data.size()), yuv, &bufferInfo) ||
+        1 != bufferInfo.iBufferStatus)
+    {
+        return false;
+    }
+    planes.y = yuv[0];
+    planes.u = yuv[1];
+    planes.v = yuv[2];
+    planes.yStride = bufferInfo.UsrData.sSystemBuffer.iStride[0];
+    planes.uvStride = bufferInfo.UsrData.sSystemBuffer.iStride[1];
+    planes.width = bufferInfo.UsrData.sSystemBuffer.iWidth;
+    planes.height = bufferInfo.UsrData.sSystemBuffer.iHeight;
+    return true;
+}
+#else
+H264Decoder::H264Decoder()
+    : m_decoder{nullptr}
+{
+}
+
+H264Decoder::~H264Decoder()
+{
+}
+
+bool H264Decoder::available()
+{
+    return false;
+}
+
+bool H264Decoder::decode(const std::string &, YuvPlanes &)
+{
+    return false;
+}
+#endif
@@ -0,0 +1,40 @@
+#ifndef H264DECODER
+#define H264DECODER
+
+#include <cstdint>
+#include <string>
+
+class ISVCDecoder;
+
+// Planes of a decoded I420 picture; they point into the decoder and are valid until the next decode().
+struct YuvPlanes
+{
+    const uint8_t *y;
+    const uint8_t *u;
+    const uint8_t *v;
+    int yStride;
+    int uvStride;
+    int width;
+    int height;
+};
+
+// Decodes the h264 frames of ImageReading messages in-process with openh264. Without openh264 at build
+// time (HAVE_OPENH264 undefined) available() is false and every decode() fails.
+class H264Decoder
+{
+private:
+    ISVCDecoder *m_decoder;
+
+public:
+    H264Decoder();
+    ~H264Decoder();
+    H264Decoder(const H264Decoder &) = delete;
+    H264Decoder &operator=(const H264Decoder &) = delete;
+
+    static bool available();
+
+    // Returns true when the access unit completed a picture.
+    bool decode(const std::string &data, YuvPlanes &planes);
+};
+
+#endif
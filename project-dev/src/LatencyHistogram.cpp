@@ -0,0 +1,117 @@
+#include "LatencyHistogram.hpp"
+
+#include <cstdio>
+#include <ostream>
+
+const int LatencyHistogram::SUB_BUCKET_BITS;
+const uint64_t LatencyHistogram::SUB_BUCKETS;
+const int LatencyHistogram::MAX_EXPONENT;
+const size_t LatencyHistogram::BUCKETS;
+
+LatencyHistogram::LatencyHistogram()
+    : m_counts(), m_count{0}, m_max{0}
+{
+    for (std::atomic<uint64_t> &counter : m_counts)
+    {
+        counter.store(0, std::memory_order_relaxed);
+    }
+}
+
+size_t LatencyHistogram::bucket(uint64_t nanoseconds)
+{
+    if (nanoseconds < SUB_BUCKETS)
+    {
+        return static_cast<size_t>(nanoseconds);
+    }
+    // Values from 2^(e + 5) to 2^(e + 6) - 1 fall into the 32 buckets of exponent e, each 2^e wide.
+    const int MSB = 63 - __builtin_clzll(nanoseconds);
+    const int EXPONENT = MSB - SUB_BUCKET_BITS;
+    if (EXPONENT > MAX_EXPONENT - 1)
+    {
+        return BUCKETS - 1;
+    }
+    return static_cast<size_t>(SUB_BUCKETS * static_cast<uint64_t>(EXPONENT + 1) + ((nanoseconds >> EXPONENT) - SUB_BUCKETS));
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t bucket)
+{
+    if (bucket < SUB_BUCKETS)
+    {
+        return bucket;
+    }
+    const uint64_t EXPONENT = bucket / SUB_BUCKETS - 1;
+    const uint64_t SUB_BUCKET = bucket % SUB_BUCKETS;
+    return ((SUB_BUCKETS + SUB_BUCKET + 1) << EXPONENT) - 1;
+}
+
+uint64_t LatencyHistogram::percentile(double percent) const
+{
+    const uint64_t COUNT = count();
+    if (COUNT == 0)
+    {
+        return 0;
+    }
+    // Rank of the value, rounded up, so that p100 is the largest value.
+    const double EXACT_RANK = percent / 100.0 * static_cast<double>(COUNT);
+    uint64_t rank = static_cast<uint64_t>(EXACT_RANK);
+    if (static_cast<double>(rank) < EXACT_RANK || rank == 0)
+    {
+        rank++;
+    }
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; i++)
+    {
+        seen += m_counts[i].load(std::memory_order_relaxed);
+        if (seen >= rank)
+        {
+            const uint64_t BOUND = bucketUpperBound(i);
+            return BOUND < max() ? BOUND : max();
+        }
+    }
+    return max();
+}
+
+LatencyProfile::LatencyProfile()
+    : m_histograms{}, m_counters{}
+{
+}
+
+LatencyHistogram &LatencyProfile::add(const std::string &name)
+{
+    m_histograms.emplace_back(name, std::unique_ptr<LatencyHistogram>{new LatencyHistogram});
+    return *m_histograms.back().second;
+}
+
+std::atomic<uint64_t> &LatencyProfile::addCounter(const std::string &name)
+{
+    m_counters.emplace_back(name, std::unique_ptr<std::atomic<uint64_t>>{new std::atomic<uint64_t>{0}});
+    return *m_counters.back().second;
+}
+
+void LatencyProfile::print(std::ostream &out) const
+{
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-14s %10s %10s %10s %10s %10s %10s", "Latency [us]", "count", "p50", "p90", "p99", "p99.9", "max");
+    out << line << "\n";
+    for (const auto &histogram : m_histograms)
+    {
+        const LatencyHistogram &H = *histogram.second;
+        // Stages that are not used in this configuration are left out.
+        if (H.count() == 0)
+        {
+            continue;
+        }
+        std::snprintf(line, sizeof(line), "%-14s %10llu %10.1f %10.1f %10.1f %10.1f %10.1f", histogram.first.c_str(),
+                      static_cast<unsigned long long>(H.count()), static_cast<double>(H.percentile(50.0)) / 1000.0,
+                      static_cast<double>(H.percentile(90.0)) / 1000.0, static_cast<double>(H.percentile(99.0)) / 1000.0,
+                      static_cast<double>(H.percentile(99.9)) / 1000.0, static_cast<double>(H.max()) / 1000.0);
+        out << line << "\n";
+    }
+    for (const auto &counter : m_counters)
+    {
+        std::snprintf(line, sizeof(line), "%-25s %10llu", counter.first.c_str(),
+                      static_cast<unsigned long long>(counter.second->load(std::memory_order_relaxed)));
+        out << line << "\n";
+    }
+    out.flush();
+}
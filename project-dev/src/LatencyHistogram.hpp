@@ -0,0 +1,95 @@
+#ifndef LATENCYHISTOGRAM
+#define LATENCYHISTOGRAM
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Histogram of durations in nanoseconds with fixed, log-linear buckets in the style of HdrHistogram:
+// every power of two is split into 32 buckets, so percentiles are accurate to about 3% from 32 ns up to
+// about 36 minutes. Recording is a few instructions without locks or allocations. Only one thread may
+// record into a histogram, but any thread may read it at the same time.
+class LatencyHistogram
+{
+public:
+    static const int SUB_BUCKET_BITS = 5;
+    static const uint64_t SUB_BUCKETS = uint64_t{1} << SUB_BUCKET_BITS;
+    static const int MAX_EXPONENT = 36;
+    static const size_t BUCKETS = SUB_BUCKETS * (MAX_EXPONENT + 1);
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS> m_counts;
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_max;
+
+    static size_t bucket(uint64_t nanoseconds);
+    static uint64_t bucketUpperBound(size_t bucket);
+
+public:
+    LatencyHistogram();
+    LatencyHistogram(const LatencyHistogram &) = delete;
+    LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+    void record(uint64_t nanoseconds)
+    {
+        // Single writer: plain loads and stores instead of read-modify-write instructions.
+        std::atomic<uint64_t> &counter = m_counts[bucket(nanoseconds)];
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        m_count.store(m_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (nanoseconds > m_max.load(std::memory_order_relaxed))
+        {
+            m_max.store(nanoseconds, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t count() const { return m_count.load(std::memory_order_relaxed); }
+    uint64_t max() const { return m_max.load(std::memory_order_relaxed); }
+    // Smallest recorded bucket bound below which the given percentage (0-100) of the values lie.
+    uint64_t percentile(double percent) const;
+};
+
+// Measures consecutive intervals of a thread: lap() records the time since the previous lap (or start()).
+class StopWatch
+{
+private:
+    std::chrono::steady_clock::time_point m_last;
+
+public:
+    StopWatch() : m_last{std::chrono::steady_clock::now()} {}
+
+    void start() { m_last = std::chrono::steady_clock::now(); }
+    void lap(LatencyHistogram &histogram)
+    {
+        const std::chrono::steady_clock::time_point NOW = std::chrono::steady_clock::now();
+        histogram.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(NOW - m_last).count()));
+        m_last = NOW;
+    }
+};
+
+// Named histograms, e.g. one per stage of the frame processing, and event counters that are reported together.
+class LatencyProfile
+{
+private:
+    std::vector<std::pair<std::string, std::unique_ptr<LatencyHistogram>>> m_histograms;
+    std::vector<std::pair<std::string, std::unique_ptr<std::atomic<uint64_t>>>> m_counters;
+
+public:
+    LatencyProfile();
+
+    // Must not be called while frames are processed.
+    LatencyHistogram &add(const std::string &name);
+    // Must not be called while frames are processed.
+    std::atomic<uint64_t> &addCounter(const std::string &name);
+    // Prints count, p50, p90, p99, p99.9 and max in microseconds for every histogram with values,
+    // followed by the counters.
+    void print(std::ostream &out) const;
+};
+
+#endif
@@ -0,0 +1,246 @@
+#include "ParameterTuner.hpp"
+#include "BlobExtractor.hpp"
+#include "ConeDetector.hpp"
+#include "Evaluation.hpp"
+#include "RecordingSource.hpp"
+
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include <algorithm>
+
+std::vector<int> ParameterRange::values() const
+{
+    std::vector<int> values;
+    for (int value = first; value <= last; value += std::max(1, step))
+    {
+        values.push_back(value);
+    }
+    return values;
+}
+
+namespace
+{
+// Replaces every item by one copy per value of the range, with the member set to that value.
+template <typename T>
+void expand(std::vector<T> &items, const ParameterRange &range, int T::*member)
+{
+    const std::vector<int> VALUES = range.values();
+    std::vector<T> expanded;
+    expanded.reserve(items.size() * VALUES.size());
+    for (const T &item : items)
+    {
+        for (int value : VALUES)
+        {
+            expanded.push_back(item);
+            expanded.back().*member = value;
+        }
+    }
+    items.swap(expanded);
+}
+
+// Moves the colour of every pixel to the centre of its cell of a lookup table with bitsPerChannel.
+void quantize(cv::Mat &bgra, int bitsPerChannel)
+{
+    const int SHIFT = 8 - bitsPerChannel;
+    const int CENTRE = (SHIFT > 0) ? (1 << (SHIFT - 1)) : 0;
+    for (int row = 0; row < bgra.rows; row++)
+    {
+        uint8_t *px = bgra.ptr<uint8_t>(row);
+        for (int col = 0; col < bgra.cols; col++, px += 4)
+        {
+            for (int channel = 0; channel < 3; channel++)
+            {
+                px[channel] = static_cast<uint8_t>(((px[channel] >> SHIFT) << SHIFT) | CENTRE);
+            }
+        }
+    }
+}
+} // namespace
+
+std::vector<HsvRange> HsvRangeGrid::ranges() const
+{
+    std::vector<HsvRange> ranges{HsvRange{0, 0, 0, 0, 0, 0}};
+    expand(ranges, minHue, &HsvRange::minHue);
+    expand(ranges, maxHue, &HsvRange::maxHue);
+    expand(ranges, minSat, &HsvRange::minSat);
+    expand(ranges, maxSat, &HsvRange::maxSat);
+    expand(ranges, minVal, &HsvRange::minVal);
+    expand(ranges, maxVal, &HsvRange::maxVal);
+    ranges.erase(std::remove_if(ranges.begin(), ranges.end(), [](const HsvRange &range)
+                                { return range.minHue > range.maxHue || range.minSat > range.maxSat || range.minVal > range.maxVal; }),
+                 ranges.end());
+    return ranges;
+}
+
+std::vector<SteeringThresholds> SteeringGrid::thresholds(const SteeringThresholds &base) const
+{
+    std::vector<SteeringThresholds> thresholds{base};
+    expand(thresholds, carPosition, &SteeringThresholds::carPosition);
+    expand(thresholds, leftThreshold, &SteeringThresholds::leftThreshold);
+    expand(thresholds, rightThreshold, &SteeringThresholds::rightThreshold);
+    thresholds.erase(std::remove_if(thresholds.begin(), thresholds.end(), [](const SteeringThresholds &t)
+                                    { return !(t.leftThreshold < t.carPosition && t.carPosition < t.rightThreshold); }),
+                     thresholds.end());
+    return thresholds;
+}
+
+bool loadTuningRecording(const std::string &fileName, const FrameAcquisition &acquisition, const TuningMode &mode,
+                         TuningRecording &recording)
+{
+    RecordingSource source{fileName, acquisition};
+    if (!source.valid())
+    {
+        return false;
+    }
+    recording.name = fileName;
+    Frame frame;
+    cv::Mat band;
+    while (source.next(frame))
+    {
+        frame.band.copyTo(band);
+        if (!mode.exactSegmentation)
+        {
+            quantize(band, mode.lutBits);
+        }
+        cv::Mat hsv;
+        cv::cvtColor(band, hsv, CV_BGR2HSV);
+        recording.hsvBands.push_back(hsv);
+        recording.groundSteering.push_back(frame.groundSteering);
+    }
+    return true;
+}
+
+ParameterTuner::ParameterTuner(size_t threads, const TuningMode &mode)
+    : m_recordings{}, m_pool{std::max<size_t>(1, threads) - 1}, m_tracking{mode.tracking}
+{
+}
+
+void ParameterTuner::addRecording(TuningRecording &&recording)
+{
+    m_recordings.push_back(std::move(recording));
+}
+
+size_t ParameterTuner::frames() const
+{
+    size_t frames = 0;
+    for (const TuningRecording &recording : m_recordings)
+    {
+        frames += recording.hsvBands.size();
+    }
+    return frames;
+}
+
+std::vector<std::vector<TrackedCone>> ParameterTuner::cones(const std::vector<HsvRange> &ranges)
+{
+    int maxWidth = 0;
+    int maxHeight = 0;
+    for (const TuningRecording &recording : m_recordings)
+    {
+        for (const cv::Mat &band : recording.hsvBands)
+        {
+            maxWidth = std::max(maxWidth, band.cols);
+            maxHeight = std::max(maxHeight, band.rows);
+        }
+    }
+
+    std::vector<std::vector<TrackedCone>> cones(ranges.size());
+    const size_t THREADS = m_pool.threads();
+    m_pool.run(THREADS, [&](size_t thread)
+    {
+        RunLengthMask mask;
+        BlobExtractor extractor{maxWidth, maxHeight};
+        ConeTracker tracker;
+        for (size_t i = thread; i < ranges.size(); i += THREADS)
+        {
+            const HsvRange &RANGE = ranges[i];
+            std::vector<TrackedCone> &cone = cones[i];
+            cone.reserve(frames());
+            for (const TuningRecording &recording : m_recordings)
+            {
+                // The tracks do not continue into the next recording.
+                tracker.reset();
+                for (const cv::Mat &band : recording.hsvBands)
+                {
+                    mask.reset(band.rows, band.cols);
+                    for (int row = 0; row < band.rows; row++)
+                    {
+                        const uint8_t *hsv = band.ptr<uint8_t>(row);
+                        uint8_t *pixels = mask.scratchRow();
+                        for (int col = 0; col < band.cols; col++, hsv += 3)
+                        {
+                            pixels[col] = (hsv[0] >= RANGE.minHue && hsv[0] <= RANGE.maxHue &&
+                                           hsv[1] >= RANGE.minSat && hsv[1] <= RANGE.maxSat &&
+                                           hsv[2] >= RANGE.minVal && hsv[2] <= RANGE.maxVal) ? 255 : 0;
+                        }
+                        mask.appendRow(pixels);
+                    }
+                    const ConeCandidates CANDIDATES = extractor.extract(mask, MIN_CONE_AREA);
+                    if (m_tracking)
+                    {
+                        cone.push_back(tracker.update(CANDIDATES));
+                    }
+                    else
+                    {
+                        cone.push_back(TrackedCone{CANDIDATES.empty() ? cv::Point2f() : CANDIDATES.largest().centroid(), cv::Point2f(), false});
+                    }
+                }
+            }
+        }
+    });
+    return cones;
+}
+
+TuningResult ParameterTuner::tune(const HsvRangeGrid &blueGrid, const HsvRangeGrid &yellowGrid, const SteeringGrid &steeringGrid,
+                                  const SteeringThresholds &base)
+{
+    const std::vector<HsvRange> BLUE_RANGES = blueGrid.ranges();
+    const std::vector<HsvRange> YELLOW_RANGES = yellowGrid.ranges();
+    const std::vector<SteeringThresholds> THRESHOLDS = steeringGrid.thresholds(base);
+    const std::vector<std::vector<TrackedCone>> BLUE_CONES = cones(BLUE_RANGES);
+    const std::vector<std::vector<TrackedCone>> YELLOW_CONES = cones(YELLOW_RANGES);
+
+    // Combination c is (blue, yellow, thresholds) in row-major order.
+    const size_t COMBINATIONS = BLUE_RANGES.size() * YELLOW_RANGES.size() * THRESHOLDS.size();
+    std::vector<uint64_t> correctAngles(COMBINATIONS, 0);
+    const size_t THREADS = m_pool.threads();
+    m_pool.run(THREADS, [&](size_t thread)
+    {
+        for (size_t c = thread; c < COMBINATIONS; c += THREADS)
+        {
+            const std::vector<TrackedCone> &blueCones = BLUE_CONES[c / (YELLOW_RANGES.size() * THRESHOLDS.size())];
+            const std::vector<TrackedCone> &yellowCones = YELLOW_CONES[(c / THRESHOLDS.size()) % YELLOW_RANGES.size()];
+            const SteeringThresholds &THRESHOLD = THRESHOLDS[c % THRESHOLDS.size()];
+            uint64_t correct = 0;
+            size_t frame = 0;
+            for (const TuningRecording &recording : m_recordings)
+            {
+                // The estimator keeps the cones of the previous frame, so it starts over for every recording.
+                SteeringEstimator estimator{THRESHOLD};
+                for (float groundSteering : recording.groundSteering)
+                {
+                    SteeringFeatures features{};
+                    features.blueCone = blueCones[frame].position;
+                    features.yellowCone = yellowCones[frame].position;
+                    features.tracked = m_tracking;
+                    features.blueVelocity = blueCones[frame].velocity;
+                    features.yellowVelocity = yellowCones[frame].velocity;
+                    const double ANGLE = estimator.estimate(features);
+                    correct += isCorrectAngle(ANGLE, groundSteering) ? 1 : 0;
+                    frame++;
+                }
+            }
+            correctAngles[c] = correct;
+        }
+    });
+
+    TuningResult result{TuningParameters{BLUE_CONE_RANGE, YELLOW_CONE_RANGE, base}, frames(), 0, COMBINATIONS};
+    if (COMBINATIONS > 0)
+    {
+        const size_t BEST = static_cast<size_t>(std::max_element(correctAngles.begin(), correctAngles.end()) - correctAngles.begin());
+        result.best = TuningParameters{BLUE_RANGES[BEST / (YELLOW_RANGES.size() * THRESHOLDS.size())],
+                                       YELLOW_RANGES[(BEST / THRESHOLDS.size()) % YELLOW_RANGES.size()],
+                                       THRESHOLDS[BEST % THRESHOLDS.size()]};
+        result.correctAngles = correctAngles[BEST];
+    }
+    return result;
+}
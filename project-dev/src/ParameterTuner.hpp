@@ -0,0 +1,126 @@
+#ifndef PARAMETERTUNER
+#define PARAMETERTUNER
+
+#include "ConeColors.hpp"
+#include "ConeTracker.hpp"
+#include "FrameAcquisition.hpp"
+#include "SteeringEstimator.hpp"
+#include "WorkerPool.hpp"
+
+#include <opencv2/core/core.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Values first, first + step, ... up to and including last.
+struct ParameterRange
+{
+    int first;
+    int last;
+    int step;
+
+    std::vector<int> values() const;
+};
+
+// A range of values for every bound of an HsvRange.
+struct HsvRangeGrid
+{
+    ParameterRange minHue;
+    ParameterRange maxHue;
+    ParameterRange minSat;
+    ParameterRange maxSat;
+    ParameterRange minVal;
+    ParameterRange maxVal;
+
+    // All combinations with min <= max.
+    std::vector<HsvRange> ranges() const;
+};
+
+struct SteeringGrid
+{
+    ParameterRange carPosition;
+    ParameterRange leftThreshold;
+    ParameterRange rightThreshold;
+
+    // All combinations with left < car position < right, with the edges of base.
+    std::vector<SteeringThresholds> thresholds(const SteeringThresholds &base = DEFAULT_STEERING_THRESHOLDS) const;
+};
+
+struct TuningParameters
+{
+    HsvRange blue;
+    HsvRange yellow;
+    SteeringThresholds steering;
+};
+
+struct TuningResult
+{
+    TuningParameters best;
+    uint64_t frames;
+    uint64_t correctAngles;
+    uint64_t candidates;
+
+    double accuracy() const { return frames > 0 ? static_cast<double>(correctAngles) / static_cast<double>(frames) : 0.0; }
+};
+
+// The segmentation and tracking the candidates are scored with, as template-opencv runs them; a
+// combination tuned in one mode need not be the best in another.
+struct TuningMode
+{
+    bool exactSegmentation;
+    int lutBits; // per colour channel of the lookup table, unless exactSegmentation
+    bool tracking;
+};
+
+// The defaults of template-opencv.
+const TuningMode DEFAULT_TUNING_MODE{false, 6, true};
+
+// The frames of a recording as needed for tuning: the band of every frame converted to HSV once, and
+// the ground truth steering.
+struct TuningRecording
+{
+    std::string name{};
+    std::vector<cv::Mat> hsvBands{};
+    std::vector<float> groundSteering{};
+};
+
+// Decodes a recording once and keeps the HSV bands in memory; returns false if it cannot be read. Without
+// exact segmentation every colour is first moved to the centre of its cell of the lookup table, which is
+// the colour the table classifies the cell by, so the HSV ranges see what the table would.
+bool loadTuningRecording(const std::string &fileName, const FrameAcquisition &acquisition, const TuningMode &mode,
+                         TuningRecording &recording);
+
+// Grid search over the HSV ranges of both cone colours and the steering thresholds. Each stage only
+// depends on some of the parameters, so its results are computed once and shared:
+//  - the HSV conversion of the frames depends on none of them and is done when loading,
+//  - the cone of a colour in every frame, and its track, only depend on the HSV range of that colour,
+//  - only the steering estimation is repeated for every combination, on the cached cone positions.
+// Every stage runs on the worker pool.
+class ParameterTuner
+{
+private:
+    std::vector<TuningRecording> m_recordings;
+    WorkerPool m_pool;
+    bool m_tracking;
+
+    // The largest cone in every frame of all recordings ((0, 0) if there is none), or its track with
+    // tracking, per HSV range.
+    std::vector<std::vector<TrackedCone>> cones(const std::vector<HsvRange> &ranges);
+
+public:
+    // Only the tracking of the mode matters here; the segmentation is applied by loadTuningRecording.
+    ParameterTuner(size_t threads, const TuningMode &mode);
+
+    void addRecording(TuningRecording &&recording);
+    size_t frames() const;
+
+    // Returns the combination with the most angles within ANGLE_TOLERANCE of the ground truth; the first
+    // one in grid order wins ties.
+    // The thresholds not in the steering grid are those of base.
+    TuningResult tune(const HsvRangeGrid &blueGrid, const HsvRangeGrid &yellowGrid, const SteeringGrid &steeringGrid,
+                      const SteeringThresholds &base = DEFAULT_STEERING_THRESHOLDS);
+};
+
+#endif
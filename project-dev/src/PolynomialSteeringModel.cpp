@@ -0,0 +1,279 @@
+#include "PolynomialSteeringModel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <sstream>
+
+const size_t SteeringInputs::COUNT;
+const size_t PolynomialSteeringModel::TERMS;
+
+namespace
+{
+const char *const MODEL_HEADER = "polynomial-steering-model 1";
+
+// Solves a x = b for a symmetric positive definite a (n x n, row-major) with a Cholesky decomposition;
+// a is overwritten. Returns false if a is not positive definite.
+bool solveCholesky(std::vector<double> &a, std::vector<double> &b, size_t n)
+{
+    for (size_t j = 0; j < n; j++)
+    {
+        double diagonal = a[j * n + j];
+        for (size_t k = 0; k < j; k++)
+        {
+            diagonal -= a[j * n + k] * a[j * n + k];
+        }
+        if (!(diagonal > 1e-12))
+        {
+            return false;
+        }
+        a[j * n + j] = std::sqrt(diagonal);
+        for (size_t i = j + 1; i < n; i++)
+        {
+            double sum = a[i * n + j];
+            for (size_t k = 0; k < j; k++)
+            {
+                sum -= a[i * n + k] * a[j * n + k];
+            }
+            a[i * n + j] = sum / a[j * n + j];
+        }
+    }
+    // L y = b, then L^T x = y.
+    for (size_t i = 0; i < n; i++)
+    {
+        for (size_t k = 0; k < i; k++)
+        {
+            b[i] -= a[i * n + k] * b[k];
+        }
+        b[i] /= a[i * n + i];
+    }
+    for (size_t i = n; i-- > 0;)
+    {
+        for (size_t k = i + 1; k < n; k++)
+        {
+            b[i] -= a[k * n + i] * b[k];
+        }
+        b[i] /= a[i * n + i];
+    }
+    return true;
+}
+
+template <size_t N>
+bool readValues(std::istream &in, const std::string &name, std::array<float, N> &values, std::string &error)
+{
+    std::string line;
+    std::string key;
+    if (!std::getline(in, line))
+    {
+        error = "'" + name + "' is missing";
+        return false;
+    }
+    std::istringstream fields(line);
+    std::string rest;
+    if (!(fields >> key) || key != name)
+    {
+        error = "expected '" + name + "' instead of '" + line + "'";
+        return false;
+    }
+    for (float &value : values)
+    {
+        if (!(fields >> value))
+        {
+            error = "'" + name + "' needs " + std::to_string(N) + " values";
+            return false;
+        }
+    }
+    if (fields >> rest)
+    {
+        error = "'" + name + "' has more than " + std::to_string(N) + " values";
+        return false;
+    }
+    return true;
+}
+
+template <size_t N>
+void writeValues(std::ostream &out, const std::string &name, const std::array<float, N> &values)
+{
+    out << name;
+    for (float value : values)
+    {
+        out << ' ' << value;
+    }
+    out << '\n';
+}
+} // namespace
+
+SteeringInputs::SteeringInputs()
+    : m_previousBlueCone{}, m_previousYellowCone{}
+{
+}
+
+SteeringInputs::Values SteeringInputs::next(const SteeringFeatures &features)
+{
+    const float BLUE_X = features.blueCone.x;
+    const float YELLOW_X = features.yellowCone.x;
+    const Values VALUES{BLUE_X, YELLOW_X, static_cast<float>(features.blueArea), static_cast<float>(features.yellowArea),
+                        static_cast<float>(features.blueBlobs), static_cast<float>(features.yellowBlobs),
+                        (BLUE_X > 0.0f && m_previousBlueCone.x > 0.0f) ? BLUE_X - m_previousBlueCone.x : 0.0f,
+                        (YELLOW_X > 0.0f && m_previousYellowCone.x > 0.0f) ? YELLOW_X - m_previousYellowCone.x : 0.0f};
+    m_previousBlueCone = features.blueCone;
+    m_previousYellowCone = features.yellowCone;
+    return VALUES;
+}
+
+PolynomialSteeringModel::PolynomialSteeringModel(const PolynomialSteeringParameters &parameters)
+    : m_parameters(parameters), m_inputs{}
+{
+}
+
+PolynomialSteeringModel::Terms PolynomialSteeringModel::terms(const SteeringInputs::Values &inputs, const PolynomialSteeringParameters &parameters)
+{
+    SteeringInputs::Values x;
+    for (size_t i = 0; i < SteeringInputs::COUNT; i++)
+    {
+        x[i] = (inputs[i] - parameters.mean[i]) * parameters.scale[i];
+    }
+    return Terms{1.0f, x[0], x[1], x[2], x[3], x[4], x[5], x[6], x[7],
+                 x[0] * x[0], x[1] * x[1], x[0] * x[1], x[0] * x[6], x[1] * x[7],
+                 inputs[0] > 0.0f ? 1.0f : 0.0f, inputs[1] > 0.0f ? 1.0f : 0.0f};
+}
+
+double PolynomialSteeringModel::estimate(const SteeringFeatures &features)
+{
+    const Terms TERMS_OF_FRAME = terms(m_inputs.next(features), m_parameters);
+    float angle = 0.0f;
+    for (size_t i = 0; i < TERMS; i++)
+    {
+        angle += TERMS_OF_FRAME[i] * m_parameters.weights[i];
+    }
+    return std::min(std::max(angle, m_parameters.minAngle), m_parameters.maxAngle);
+}
+
+bool fitPolynomialSteeringModel(const std::vector<std::vector<SteeringRecord>> &logs, double ridge,
+                                PolynomialSteeringParameters &parameters, std::string &error)
+{
+    const size_t N = PolynomialSteeringModel::TERMS;
+    std::vector<SteeringInputs::Values> inputs;
+    std::vector<float> angles;
+    for (const std::vector<SteeringRecord> &records : logs)
+    {
+        SteeringInputs sequence;
+        for (const SteeringRecord &record : records)
+        {
+            inputs.push_back(sequence.next(makeSteeringFeatures(record)));
+            angles.push_back(record.groundSteering);
+        }
+    }
+    if (inputs.empty())
+    {
+        error = "no records to fit";
+        return false;
+    }
+
+    // Standardise every input; inputs that never change get weight 0.
+    PolynomialSteeringParameters fitted{};
+    const double COUNT = static_cast<double>(inputs.size());
+    for (size_t i = 0; i < SteeringInputs::COUNT; i++)
+    {
+        double sum = 0.0;
+        double squares = 0.0;
+        for (const SteeringInputs::Values &values : inputs)
+        {
+            sum += values[i];
+            squares += static_cast<double>(values[i]) * values[i];
+        }
+        const double MEAN = sum / COUNT;
+        const double DEVIATION = std::sqrt(std::max(0.0, squares / COUNT - MEAN * MEAN));
+        fitted.mean[i] = static_cast<float>(MEAN);
+        fitted.scale[i] = DEVIATION > 1e-6 ? static_cast<float>(1.0 / DEVIATION) : 0.0f;
+    }
+
+    // Normal equations (T^T T + ridge I) w = T^T y.
+    std::vector<double> normal(N * N, 0.0);
+    std::vector<double> rightSide(N, 0.0);
+    for (size_t r = 0; r < inputs.size(); r++)
+    {
+        const PolynomialSteeringModel::Terms TERMS = PolynomialSteeringModel::terms(inputs[r], fitted);
+        for (size_t i = 0; i < N; i++)
+        {
+            for (size_t j = 0; j <= i; j++)
+            {
+                normal[i * N + j] += static_cast<double>(TERMS[i]) * TERMS[j];
+            }
+            rightSide[i] += static_cast<double>(TERMS[i]) * angles[r];
+        }
+    }
+    for (size_t i = 0; i < N; i++)
+    {
+        for (size_t j = 0; j < i; j++)
+        {
+            normal[j * N + i] = normal[i * N + j];
+        }
+        // Terms that are always 0 would make the system singular; the ridge keeps their weight at 0.
+        normal[i * N + i] += (i == 0) ? 0.0 : std::max(ridge * COUNT, 1e-9);
+    }
+    if (!solveCholesky(normal, rightSide, N))
+    {
+        error = "the fit has no unique solution";
+        return false;
+    }
+    for (size_t i = 0; i < N; i++)
+    {
+        fitted.weights[i] = static_cast<float>(rightSide[i]);
+    }
+    fitted.minAngle = *std::min_element(angles.begin(), angles.end());
+    fitted.maxAngle = *std::max_element(angles.begin(), angles.end());
+    parameters = fitted;
+    return true;
+}
+
+void writeSteeringModel(std::ostream &out, const PolynomialSteeringParameters &parameters)
+{
+    const std::streamsize PRECISION = out.precision(std::numeric_limits<float>::max_digits10);
+    out << MODEL_HEADER << '\n';
+    writeValues(out, "mean", parameters.mean);
+    writeValues(out, "scale", parameters.scale);
+    writeValues(out, "weights", parameters.weights);
+    out << "angles " << parameters.minAngle << ' ' << parameters.maxAngle << '\n';
+    out.precision(PRECISION);
+}
+
+bool readSteeringModel(std::istream &in, PolynomialSteeringParameters &parameters, std::string &error)
+{
+    PolynomialSteeringParameters read{};
+    std::string line;
+    if (!std::getline(in, line) || line != MODEL_HEADER)
+    {
+        error = "not a polynomial steering model";
+        return false;
+    }
+    std::array<float, 2> angles{};
+    if (!readValues(in, "mean", read.mean, error) || !readValues(in, "scale", read.scale, error) ||
+        !readValues(in, "weights", read.weights, error) || !readValues(in, "angles", angles, error))
+    {
+        return false;
+    }
+    if (!(angles[0] <= angles[1]))
+    {
+        error = "the minimum angle is larger than the maximum";
+        return false;
+    }
+    read.minAngle = angles[0];
+    read.maxAngle = angles[1];
+    parameters = read;
+    return true;
+}
+
+bool loadSteeringModel(const std::string &fileName, PolynomialSteeringParameters &parameters, std::string &error)
+{
+    std::ifstream in(fileName);
+    if (!in)
+    {
+        error = "cannot open " + fileName;
+        return false;
+    }
+    return readSteeringModel(in, parameters, error);
+}
@@ -0,0 +1,78 @@
+#ifndef POLYNOMIALSTEERINGMODEL
+#define POLYNOMIALSTEERINGMODEL
+
+#include "SteeringLog.hpp"
+#include "SteeringModel.hpp"
+
+#include <array>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// The inputs of the polynomial for one frame: the x, area and number of blobs of both cone colours and
+// how far the cones moved since the previous frame (0 unless the cone is in both frames), which tells
+// the driving direction.
+class SteeringInputs
+{
+public:
+    static const size_t COUNT = 8;
+    using Values = std::array<float, COUNT>;
+
+private:
+    cv::Point2f m_previousBlueCone;
+    cv::Point2f m_previousYellowCone;
+
+public:
+    SteeringInputs();
+
+    Values next(const SteeringFeatures &features);
+};
+
+// Fitted by fitPolynomialSteeringModel and stored with writeSteeringModel.
+struct PolynomialSteeringParameters
+{
+    // The inputs are standardised as (input - mean) * scale before the terms are formed.
+    SteeringInputs::Values mean;
+    SteeringInputs::Values scale;
+    std::array<float, 16> weights; // one per term of PolynomialSteeringModel
+    // Range of the ground truth the model was fitted to; the angles are clamped to it.
+    float minAngle;
+    float maxAngle;
+};
+
+// Continuous steering wheel angle as a second order polynomial of the standardised inputs: a constant,
+// the inputs, the squares and the product of the cone positions, each position times its movement and
+// whether each cone is seen. All sizes are fixed, so estimate() is a few dozen multiply-adds over small
+// float arrays the compiler vectorises, and it does not allocate.
+class PolynomialSteeringModel : public SteeringModel
+{
+public:
+    static const size_t TERMS = 16;
+    using Terms = std::array<float, TERMS>;
+
+private:
+    PolynomialSteeringParameters m_parameters;
+    SteeringInputs m_inputs;
+
+public:
+    explicit PolynomialSteeringModel(const PolynomialSteeringParameters &parameters);
+
+    static Terms terms(const SteeringInputs::Values &inputs, const PolynomialSteeringParameters &parameters);
+
+    double estimate(const SteeringFeatures &features) override;
+};
+
+// Least squares fit of the weights to the ground truth of steering logs, with ridge regularisation of all
+// weights but the constant. Every log is a sequence of consecutive frames. Returns false and describes
+// why in `error` if there are no records or the fit has no unique solution.
+bool fitPolynomialSteeringModel(const std::vector<std::vector<SteeringRecord>> &logs, double ridge,
+                                PolynomialSteeringParameters &parameters, std::string &error);
+
+// Text format: a "polynomial-steering-model 1" line, then the lines "mean", "scale" and "weights" followed
+// by their values and an "angles <min> <max>" line.
+void writeSteeringModel(std::ostream &out, const PolynomialSteeringParameters &parameters);
+bool readSteeringModel(std::istream &in, PolynomialSteeringParameters &parameters, std::string &error);
+bool loadSteeringModel(const std::string &fileName, PolynomialSteeringParameters &parameters, std::string &error);
+
+#endif
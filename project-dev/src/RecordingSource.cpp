@@ -0,0 +1,99 @@
+#include "RecordingSource.hpp"
+
+#include "cluon-complete.hpp"
+#include "opendlv-standard-message-set.hpp"
+
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+
+RecordingSource::RecordingSource(const std::string &fileName, const FrameAcquisition &acquisition)
+    : m_player{new cluon::Player{fileName, false, false}}, m_acquisition(acquisition), m_decoder{}, m_i420{}, m_bgra{},
+      m_groundSteering{0.0f}, m_skippedFrames{0}
+{
+    m_bgra.create(static_cast<int>(acquisition.height()), static_cast<int>(acquisition.width()), CV_8UC4);
+}
+
+RecordingSource::~RecordingSource()
+{
+}
+
+bool RecordingSource::valid() const
+{
+    return m_player->hasMoreData();
+}
+
+bool RecordingSource::next(Frame &frame)
+{
+    while (m_player->hasMoreData())
+    {
+        auto next = m_player->getNextEnvelopeToBeReplayed();
+        if (!next.first)
+        {
+            continue;
+        }
+        cluon::data::Envelope env{std::move(next.second)};
+        if (opendlv::proxy::GroundSteeringRequest::ID() == env.dataType())
+        {
+            m_groundSteering = cluon::extractMessage<opendlv::proxy::GroundSteeringRequest>(std::move(env)).groundSteering();
+        }
+        else if (opendlv::proxy::ImageReading::ID() == env.dataType())
+        {
+            const int64_t SAMPLE_TIME_STAMP{cluon::time::toMicroseconds(env.sampleTimeStamp())};
+            opendlv::proxy::ImageReading image = cluon::extractMessage<opendlv::proxy::ImageReading>(std::move(env));
+            YuvPlanes planes;
+            if ("h264" != image.fourcc() || !m_decoder.decode(image.data(), planes) ||
+                planes.width != m_bgra.cols || planes.height != m_bgra.rows)
+            {
+                m_skippedFrames++;
+                continue;
+            }
+
+            // Only the rows that are copied out are converted to BGRA; I420 needs them in pairs.
+            const RegionOfInterest &ROI = m_acquisition.roi();
+            if (m_acquisition.copiesFullFrame())
+            {
+                convertRows(planes, 0, m_bgra.rows);
+            }
+            else
+            {
+                convertRows(planes, ROI.top & ~1, std::min(m_bgra.rows, (ROI.bottom + 1) & ~1));
+            }
+            m_acquisition.copyFrom(reinterpret_cast<const char *>(m_bgra.data), frame);
+            frame.sampleTimeStamp = SAMPLE_TIME_STAMP;
+            frame.groundSteering = m_groundSteering;
+            return true;
+        }
+    }
+    return false;
+}
+
+void RecordingSource::convertRows(const YuvPlanes &planes, int rowBegin, int rowEnd)
+{
+    const int ROWS = rowEnd - rowBegin;
+    if (ROWS <= 0)
+    {
+        return;
+    }
+    // Pack the rows into a contiguous I420 image: the luma rows followed by the matching chroma rows.
+    const size_t WIDTH = static_cast<size_t>(planes.width);
+    const size_t CHROMA_WIDTH = WIDTH / 2;
+    m_i420.create(ROWS * 3 / 2, planes.width, CV_8UC1);
+    uint8_t *out = m_i420.data;
+    for (int row = rowBegin; row < rowEnd; row++, out += WIDTH)
+    {
+        std::memcpy(out, planes.y + row * planes.yStride, WIDTH);
+    }
+    for (const uint8_t *plane : {planes.u, planes.v})
+    {
+        for (int row = rowBegin / 2; row < rowEnd / 2; row++, out += CHROMA_WIDTH)
+        {
+            std::memcpy(out, plane + row * planes.uvStride, CHROMA_WIDTH);
+        }
+    }
+
+    cv::Mat rows = m_bgra.rowRange(rowBegin, rowEnd);
+    cv::cvtColor(m_i420, rows, cv::COLOR_YUV2BGRA_I420);
+}
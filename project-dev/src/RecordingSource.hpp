@@ -0,0 +1,49 @@
+#ifndef RECORDINGSOURCE
+#define RECORDINGSOURCE
+
+#include "Frame.hpp"
+#include "FrameAcquisition.hpp"
+#include "H264Decoder.hpp"
+
+#include <opencv2/core/core.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace cluon
+{
+class Player;
+}
+
+// Reads frames straight from a .rec file for offline evaluation: the ImageReading envelopes are decoded
+// in-process and the latest GroundSteeringRequest becomes the ground truth of the following frame. The
+// recording is replayed as fast as the frames are processed; there is no shared memory and no waiting.
+class RecordingSource
+{
+private:
+    std::unique_ptr<cluon::Player> m_player;
+    const FrameAcquisition &m_acquisition;
+    H264Decoder m_decoder;
+    cv::Mat m_i420;
+    cv::Mat m_bgra;
+    float m_groundSteering;
+    uint64_t m_skippedFrames;
+
+    void convertRows(const YuvPlanes &planes, int rowBegin, int rowEnd);
+
+public:
+    RecordingSource(const std::string &fileName, const FrameAcquisition &acquisition);
+    ~RecordingSource();
+    RecordingSource(const RecordingSource &) = delete;
+    RecordingSource &operator=(const RecordingSource &) = delete;
+
+    // False if the recording could not be opened or is empty.
+    bool valid() const;
+    // Fills the next frame; returns false at the end of the recording.
+    bool next(Frame &frame);
+    // Images that could not be decoded or do not have the size of the acquisition.
+    uint64_t skippedFrames() const { return m_skippedFrames; }
+};
+
+#endif
@@ -0,0 +1,74 @@
+#include "RegionController.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+const int RegionController::MARGIN;
+const int RegionController::REFRESH_FRAMES;
+
+namespace
+{
+// Bounds of the part of the band the cones are in: columns [left, right) and rows [top, bottom).
+struct Hull
+{
+    float left;
+    float top;
+    float right;
+    float bottom;
+
+    void add(float x, float y)
+    {
+        left = std::min(left, x);
+        top = std::min(top, y);
+        right = std::max(right, x + 1.0f);
+        bottom = std::max(bottom, y + 1.0f);
+    }
+};
+} // namespace
+
+RegionController::RegionController(int bandWidth, int bandHeight)
+    : m_bandWidth{bandWidth}, m_bandHeight{bandHeight}, m_mutex{}, m_window{}, m_framesSinceRefresh{0}
+{
+}
+
+cv::Rect RegionController::next()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_window.width == 0 || ++m_framesSinceRefresh >= REFRESH_FRAMES)
+    {
+        m_framesSinceRefresh = 0;
+        return cv::Rect();
+    }
+    return m_window;
+}
+
+void RegionController::update(const Frame &frame)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // A cone that is not detected, even if its track still coasts, may have left the window and show up
+    // anywhere; a cone at (0, 0) is not seen at all.
+    if (frame.blueCandidates.empty() || frame.yellowCandidates.empty() || frame.blueCone.x <= 0.0f || frame.yellowCone.x <= 0.0f)
+    {
+        m_window = cv::Rect();
+        return;
+    }
+
+    Hull hull{frame.blueCone.x, frame.blueCone.y, frame.blueCone.x + 1.0f, frame.blueCone.y + 1.0f};
+    hull.add(frame.blueCone.x + frame.blueVelocity.x, frame.blueCone.y + frame.blueVelocity.y);
+    hull.add(frame.yellowCone.x, frame.yellowCone.y);
+    hull.add(frame.yellowCone.x + frame.yellowVelocity.x, frame.yellowCone.y + frame.yellowVelocity.y);
+    for (const ConeCandidates *candidates : {&frame.blueCandidates, &frame.yellowCandidates})
+    {
+        for (const ConeCandidate &candidate : *candidates)
+        {
+            hull.add(static_cast<float>(candidate.left), static_cast<float>(candidate.top));
+            hull.add(static_cast<float>(candidate.right - 1), static_cast<float>(candidate.bottom - 1));
+        }
+    }
+
+    const int LEFT = std::max(0, static_cast<int>(std::floor(hull.left)) - MARGIN);
+    const int TOP = std::max(0, static_cast<int>(std::floor(hull.top)) - MARGIN);
+    const int RIGHT = std::min(m_bandWidth, static_cast<int>(std::ceil(hull.right)) + MARGIN);
+    const int BOTTOM = std::min(m_bandHeight, static_cast<int>(std::ceil(hull.bottom)) + MARGIN);
+    m_window = (LEFT < RIGHT && TOP < BOTTOM) ? cv::Rect(LEFT, TOP, RIGHT - LEFT, BOTTOM - TOP) : cv::Rect();
+}
@@ -0,0 +1,43 @@
+#ifndef REGIONCONTROLLER
+#define REGIONCONTROLLER
+
+#include "Frame.hpp"
+
+#include <opencv2/core/core.hpp>
+
+#include <mutex>
+
+// Chooses the window of the band that is searched for cones, so that while both cones are followed only
+// their neighbourhood is segmented and labelled instead of the whole band.
+//
+// After every frame the window is narrowed to the bounding boxes of the candidates and the cones where
+// they are expected in the next frame (their position plus velocity), grown by MARGIN on every side. When
+// no cone of either colour is detected the next frame searches the whole band, as does every
+// REFRESH_FRAMES-th frame so that cones appearing outside the window are found.
+//
+// With the stages on their own threads the segmentation takes the window for a frame while the estimation
+// still reports earlier ones, so both calls are serialised; the window then lags by the frames in flight,
+// which the margin covers.
+class RegionController
+{
+public:
+    static const int MARGIN = 40; // pixels, the gate of the cone tracker
+    static const int REFRESH_FRAMES = 15;
+
+private:
+    int m_bandWidth;
+    int m_bandHeight;
+    std::mutex m_mutex;
+    cv::Rect m_window;
+    int m_framesSinceRefresh;
+
+public:
+    RegionController(int bandWidth, int bandHeight);
+
+    // The window to search in the next frame, empty for the whole band.
+    cv::Rect next();
+    // Adapts the window to the cones of a searched frame; frames must be passed in order.
+    void update(const Frame &frame);
+};
+
+#endif
@@ -0,0 +1,112 @@
+#include "RunLengthMask.hpp"
+
+#include <cstring>
+
+RunLengthMask::RunLengthMask()
+    : m_rows{0}, m_cols{0}, m_runs{}, m_rowOffsets{}, m_scratchRow{}
+{
+}
+
+void RunLengthMask::reset(int rows, int cols)
+{
+    m_rows = rows;
+    m_cols = cols;
+    m_runs.clear();
+    m_rowOffsets.clear();
+    // Reserve for the worst case (every second pixel set) so that appending never reallocates.
+    m_runs.reserve(static_cast<size_t>(rows) * static_cast<size_t>(cols / 2 + 1));
+    m_rowOffsets.reserve(static_cast<size_t>(rows) + 1);
+    m_rowOffsets.push_back(0);
+    m_scratchRow.resize(static_cast<size_t>(cols));
+}
+
+void RunLengthMask::appendRow(const uint8_t *pixels)
+{
+    int col = 0;
+    while (col < m_cols)
+    {
+        // Masks are sparse, so skip empty pixels eight at a time.
+        uint64_t word;
+        if (col + 8 <= m_cols && (std::memcpy(&word, pixels + col, sizeof(word)), word == 0))
+        {
+            col += 8;
+            continue;
+        }
+        if (pixels[col] == 0)
+        {
+            col++;
+            continue;
+        }
+        MaskRun run{col, col};
+        while (run.end < m_cols && pixels[run.end] != 0)
+        {
+            run.end++;
+        }
+        col = run.end;
+        m_runs.push_back(run);
+    }
+    m_rowOffsets.push_back(m_runs.size());
+}
+
+void RunLengthMask::appendRows(const RunLengthMask &rows)
+{
+    CV_Assert(rows.cols() == m_cols);
+    const size_t offset = m_runs.size();
+    m_runs.insert(m_runs.end(), rows.m_runs.begin(), rows.m_runs.end());
+    for (int row = 1; row <= rows.rows(); row++)
+    {
+        m_rowOffsets.push_back(offset + rows.m_rowOffsets[static_cast<size_t>(row)]);
+    }
+}
+
+size_t RunLengthMask::pixelCount() const
+{
+    size_t count = 0;
+    for (const MaskRun &run : m_runs)
+    {
+        count += static_cast<size_t>(run.end - run.begin);
+    }
+    return count;
+}
+
+void RunLengthMask::assign(const cv::Mat &mask)
+{
+    CV_Assert(mask.type() == CV_8UC1);
+    reset(mask.rows, mask.cols);
+    for (int row = 0; row < mask.rows; row++)
+    {
+        appendRow(mask.ptr<uint8_t>(row));
+    }
+}
+
+void RunLengthMask::toMat(cv::Mat &mask) const
+{
+    mask.create(m_rows, m_cols, CV_8UC1);
+    for (int row = 0; row < m_rows; row++)
+    {
+        uint8_t *pixels = mask.ptr<uint8_t>(row);
+        std::memset(pixels, 0, static_cast<size_t>(m_cols));
+        for (const MaskRun *run = rowBegin(row); run != rowEnd(row); run++)
+        {
+            std::memset(pixels + run->begin, 255, static_cast<size_t>(run->end - run->begin));
+        }
+    }
+}
+
+void RunLengthMask::draw(cv::Mat &image, const cv::Scalar &color) const
+{
+    CV_Assert(image.type() == CV_8UC4 && image.rows == m_rows && image.cols == m_cols);
+    const uint8_t BGRA[4] = {cv::saturate_cast<uint8_t>(color[0]), cv::saturate_cast<uint8_t>(color[1]),
+                             cv::saturate_cast<uint8_t>(color[2]), cv::saturate_cast<uint8_t>(color[3])};
+    for (int row = 0; row < m_rows; row++)
+    {
+        uint8_t *pixels = image.ptr<uint8_t>(row);
+        for (const MaskRun *run = rowBegin(row); run != rowEnd(row); run++)
+        {
+            for (int col = run->begin; col < run->end; col++)
+            {
+                std::memcpy(pixels + 4 * col, BGRA, sizeof(BGRA));
+            }
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef RUNLENGTHMASK
+#define RUNLENGTHMASK
+
+#include <opencv2/core/core.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A horizontal run of set pixels: columns [begin, end) of one row.
+struct MaskRun
+{
+    int begin;
+    int end;
+};
+
+// Binary mask stored as the runs of set pixels of every row. The cone masks of the band are sparse,
+// so the stages after the segmentation scale with the number of cone pixels instead of the band area.
+// Rows are appended in order; the buffers keep their capacity across frames.
+class RunLengthMask
+{
+private:
+    int m_rows;
+    int m_cols;
+    std::vector<MaskRun> m_runs;
+    std::vector<size_t> m_rowOffsets;
+    std::vector<uint8_t> m_scratchRow;
+
+public:
+    RunLengthMask();
+
+    // Starts a new, empty mask of the given size.
+    void reset(int rows, int cols);
+    // Appends the runs of the next row from its pixels (non-zero is set).
+    void appendRow(const uint8_t *pixels);
+    // Appends all rows of another mask with the same number of columns, e.g. one that holds the next rows.
+    void appendRows(const RunLengthMask &rows);
+    // A buffer of cols() bytes in which a row can be prepared before it is appended.
+    uint8_t *scratchRow() { return m_scratchRow.data(); }
+
+    int rows() const { return m_rows; }
+    int cols() const { return m_cols; }
+    size_t runCount() const { return m_runs.size(); }
+    const MaskRun *rowBegin(int row) const { return m_runs.data() + m_rowOffsets[row]; }
+    const MaskRun *rowEnd(int row) const { return m_runs.data() + m_rowOffsets[row + 1]; }
+    size_t pixelCount() const;
+
+    // Encodes a CV_8UC1 mask.
+    void assign(const cv::Mat &mask);
+    // Expands the runs into a CV_8UC1 mask with 255 for set pixels.
+    void toMat(cv::Mat &mask) const;
+    // Paints the set pixels onto an image of the same size, e.g. for debugging.
+    void draw(cv::Mat &image, const cv::Scalar &color) const;
+};
+
+#endif
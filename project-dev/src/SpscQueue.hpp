@@ -0,0 +1,106 @@
+#ifndef SPSCQUEUE
+#define SPSCQUEUE
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Waiting strategy for lock-free hand-overs: spin briefly, then yield, then sleep in short steps so that
+// idle threads do not burn a whole core on small boards.
+inline void backoff(unsigned int attempt)
+{
+    if (attempt < 64)
+    {
+        return;
+    }
+    if (attempt < 128)
+    {
+        std::this_thread::yield();
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+}
+
+// Bounded lock-free ring buffer for exactly one producer thread and one consumer thread.
+// The capacity is rounded up to a power of two; head and tail live on separate cache lines.
+template <typename T>
+class SpscQueue
+{
+private:
+    std::vector<T> m_items;
+    size_t m_mask;
+    char m_padding0[64];
+    std::atomic<size_t> m_head; // next item to pop, written by the consumer
+    char m_padding1[64];
+    std::atomic<size_t> m_tail; // next free item, written by the producer
+    char m_padding2[64];
+
+    static size_t roundUpToPowerOfTwo(size_t n)
+    {
+        size_t capacity = 1;
+        while (capacity < n)
+        {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+public:
+    explicit SpscQueue(size_t capacity)
+        : m_items(roundUpToPowerOfTwo(capacity)), m_mask{roundUpToPowerOfTwo(capacity) - 1},
+          m_padding0{}, m_head{0}, m_padding1{}, m_tail{0}, m_padding2{}
+    {
+    }
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    size_t capacity() const { return m_items.size(); }
+    size_t size() const { return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire); }
+
+    bool tryPush(const T &item)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == m_items.size())
+        {
+            return false;
+        }
+        m_items[tail & m_mask] = item;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T &item)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        item = m_items[head & m_mask];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Blocking variants, waiting with backoff().
+    void push(const T &item)
+    {
+        for (unsigned int attempt = 0; !tryPush(item); attempt++)
+        {
+            backoff(attempt);
+        }
+    }
+
+    T pop()
+    {
+        T item;
+        for (unsigned int attempt = 0; !tryPop(item); attempt++)
+        {
+            backoff(attempt);
+        }
+        return item;
+    }
+};
+
+#endif
@@ -0,0 +1,81 @@
+#include "SteeringEstimator.hpp"
+
+#include <cmath>
+
+const float SteeringEstimator::DIRECTION_DEAD_BAND = 0.5f;
+
+SteeringEstimator::SteeringEstimator(const SteeringThresholds &thresholds, const SteeringRules &rules)
+    : m_clockwise{rules.clockwise, thresholds}, m_counterClockwise{rules.counterClockwise, thresholds},
+      m_directionKnown{false}, m_direction{SteeringDirection::CLOCKWISE}, m_previousBlueCone{}, m_previousYellowCone{}, m_previousCalculatedAngle{0.0}
+{
+}
+
+double SteeringEstimator::estimate(const cv::Point2f &blueCone, const cv::Point2f &yellowCone)
+{
+    double calculatedAngle;
+
+    // checking the direction
+    if(m_previousBlueCone.x > 0){
+        if(m_previousBlueCone.x > blueCone.x){
+            // moving to the right counter clockwise
+            calculatedAngle = m_clockwise.angle(blueCone, yellowCone);
+        } else {
+            // moving to the left clockwise
+            calculatedAngle = m_counterClockwise.angle(blueCone, yellowCone);
+
+        }
+    } 
+    else if(m_previousYellowCone.x > 0){
+        if(m_previousYellowCone.x > yellowCone.x){
+             // moving to the right clockwise
+            calculatedAngle = m_counterClockwise.angle(blueCone, yellowCone);
+        } else {
+            // moving to the left counter clockwise
+            calculatedAngle = m_clockwise.angle(blueCone, yellowCone);
+         }
+    } else {
+        // if we don't know the direction we just assume the steering wheel angle to be 0.
+        calculatedAngle = m_previousCalculatedAngle;
+    }
+
+    // assign the values to the variables
+    m_previousBlueCone = blueCone;
+    m_previousYellowCone = yellowCone;
+    m_previousCalculatedAngle = calculatedAngle;
+    return calculatedAngle;
+}
+
+double SteeringEstimator::estimate(const SteeringFeatures &features)
+{
+    if (!features.tracked)
+    {
+        return estimate(features.blueCone, features.yellowCone);
+    }
+
+    // As without tracking the blue cone decides when there is one: moving to the left means driving
+    // clockwise, as does a yellow cone moving to the right.
+    if (features.blueCone.x > 0)
+    {
+        if (std::fabs(features.blueVelocity.x) > DIRECTION_DEAD_BAND)
+        {
+            m_direction = (features.blueVelocity.x < 0) ? SteeringDirection::CLOCKWISE : SteeringDirection::COUNTER_CLOCKWISE;
+            m_directionKnown = true;
+        }
+    }
+    else if (features.yellowCone.x > 0 && std::fabs(features.yellowVelocity.x) > DIRECTION_DEAD_BAND)
+    {
+        m_direction = (features.yellowVelocity.x < 0) ? SteeringDirection::COUNTER_CLOCKWISE : SteeringDirection::CLOCKWISE;
+        m_directionKnown = true;
+    }
+
+    double calculatedAngle = m_previousCalculatedAngle;
+    if (m_directionKnown)
+    {
+        const SteeringRuleTable &RULES = (m_direction == SteeringDirection::CLOCKWISE) ? m_clockwise : m_counterClockwise;
+        calculatedAngle = RULES.angle(features.blueCone, features.yellowCone);
+    }
+    m_previousBlueCone = features.blueCone;
+    m_previousYellowCone = features.yellowCone;
+    m_previousCalculatedAngle = calculatedAngle;
+    return calculatedAngle;
+}
@@ -0,0 +1,38 @@
+#ifndef STEERINGESTIMATOR
+#define STEERINGESTIMATOR
+
+#include "SteeringModel.hpp"
+#include "SteeringRules.hpp"
+
+#include <opencv2/core/core.hpp>
+
+// Derives the driving direction from how the cones move between consecutive frames and applies the
+// rules of that direction. Keeps the cones and the angle of the previous frame, so frames must be passed
+// in order. This is the rule-based SteeringModel; it only uses the centroids of the cones.
+//
+// With tracked cones the direction is taken from their filtered velocities instead, and only changes when
+// a cone moves faster than DIRECTION_DEAD_BAND; slower movement keeps the last direction, so a single
+// noisy frame does not switch the rules.
+class SteeringEstimator : public SteeringModel
+{
+public:
+    static const float DIRECTION_DEAD_BAND; // pixels per frame
+
+private:
+    SteeringRuleTable m_clockwise;
+    SteeringRuleTable m_counterClockwise;
+    bool m_directionKnown;
+    SteeringDirection m_direction;
+    cv::Point2f m_previousBlueCone;
+    cv::Point2f m_previousYellowCone;
+    double m_previousCalculatedAngle;
+
+public:
+    explicit SteeringEstimator(const SteeringThresholds &thresholds = DEFAULT_STEERING_THRESHOLDS,
+                               const SteeringRules &rules = defaultSteeringRules());
+
+    double estimate(const cv::Point2f &blueCone, const cv::Point2f &yellowCone);
+    double estimate(const SteeringFeatures &features) override;
+};
+
+#endif
@@ -0,0 +1,149 @@
+#include "SteeringLog.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <ostream>
+
+const char SteeringLog::MAGIC[8] = {'G', '1', '5', 'S', 'T', 'E', 'E', 'R'};
+const uint32_t SteeringLog::VERSION;
+
+namespace
+{
+// Records written to the file at once.
+const size_t BATCH_SIZE = 256;
+} // namespace
+
+SteeringRecord makeSteeringRecord(const Frame &frame)
+{
+    const SteeringFeatures FEATURES = makeSteeringFeatures(frame);
+    SteeringRecord record{};
+    record.sampleTimeStamp = frame.sampleTimeStamp;
+    record.calculatedAngle = frame.calculatedAngle;
+    record.groundSteering = frame.groundSteering;
+    record.blueConeX = FEATURES.blueCone.x;
+    record.yellowConeX = FEATURES.yellowCone.x;
+    record.blueConeArea = FEATURES.blueArea;
+    record.yellowConeArea = FEATURES.yellowArea;
+    record.blueBlobs = FEATURES.blueBlobs;
+    record.yellowBlobs = FEATURES.yellowBlobs;
+    return record;
+}
+
+SteeringFeatures makeSteeringFeatures(const SteeringRecord &record)
+{
+    return SteeringFeatures{cv::Point2f(record.blueConeX, 0.0f), cv::Point2f(record.yellowConeX, 0.0f),
+                            record.blueConeArea, record.yellowConeArea, record.blueBlobs, record.yellowBlobs,
+                            false, cv::Point2f(), cv::Point2f()};
+}
+
+SteeringLog::SteeringLog(const std::string &fileName, size_t capacity)
+    : m_file{fileName, std::ios::binary | std::ios::trunc}, m_ring{capacity}, m_running{true}, m_dropped{0}, m_writer{}
+{
+    if (m_file.is_open())
+    {
+        const uint32_t RECORD_SIZE = sizeof(SteeringRecord);
+        m_file.write(MAGIC, sizeof(MAGIC));
+        m_file.write(reinterpret_cast<const char *>(&VERSION), sizeof(VERSION));
+        m_file.write(reinterpret_cast<const char *>(&RECORD_SIZE), sizeof(RECORD_SIZE));
+        m_writer = std::thread(&SteeringLog::write, this);
+    }
+}
+
+SteeringLog::~SteeringLog()
+{
+    m_running.store(false);
+    if (m_writer.joinable())
+    {
+        m_writer.join();
+    }
+}
+
+void SteeringLog::log(const SteeringRecord &record)
+{
+    if (!m_file.is_open() || !m_ring.tryPush(record))
+    {
+        m_dropped++;
+    }
+}
+
+void SteeringLog::write()
+{
+    std::vector<SteeringRecord> batch;
+    batch.reserve(BATCH_SIZE);
+    for (;;)
+    {
+        // Read the flag before draining so that records logged before the shutdown are not lost.
+        const bool running = m_running.load();
+        SteeringRecord record;
+        while (batch.size() < BATCH_SIZE && m_ring.tryPop(record))
+        {
+            batch.push_back(record);
+        }
+        if (!batch.empty() && (batch.size() == BATCH_SIZE || m_ring.size() == 0))
+        {
+            m_file.write(reinterpret_cast<const char *>(batch.data()), static_cast<std::streamsize>(batch.size() * sizeof(SteeringRecord)));
+            batch.clear();
+        }
+        if (!running && m_ring.size() == 0 && batch.empty())
+        {
+            break;
+        }
+        if (m_ring.size() == 0)
+        {
+            // Frames arrive every few tens of milliseconds; there is no need to poll faster.
+            m_file.flush();
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+    m_file.close();
+}
+
+bool readSteeringLog(const std::string &fileName, std::vector<SteeringRecord> &records)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    char magic[sizeof(SteeringLog::MAGIC)];
+    uint32_t version = 0;
+    uint32_t recordSize = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char *>(&version), sizeof(version));
+    file.read(reinterpret_cast<char *>(&recordSize), sizeof(recordSize));
+    if (!file || 0 != std::memcmp(magic, SteeringLog::MAGIC, sizeof(magic)) ||
+        version != SteeringLog::VERSION || recordSize != sizeof(SteeringRecord))
+    {
+        return false;
+    }
+
+    records.clear();
+    SteeringRecord record;
+    while (file.read(reinterpret_cast<char *>(&record), sizeof(record)))
+    {
+        records.push_back(record);
+    }
+    return true;
+}
+
+void writeSteeringCsv(std::ostream &out, const std::vector<SteeringRecord> &records, bool withBlobs)
+{
+    // print to csv
+    out << "Timestamp " << ",";
+    out << "GroundSteeringRequest " << ",";
+    out << "Calculated Angle";
+    if (withBlobs)
+    {
+        out << ",Blue Cone X,Blue Cone Area,Blue Blobs,Yellow Cone X,Yellow Cone Area,Yellow Blobs";
+    }
+    out << "\n";
+
+    for (const SteeringRecord &record : records)
+    {
+        out << std::to_string(record.sampleTimeStamp) << ",";
+        out << std::to_string(record.groundSteering) << ",";
+        out << std::to_string(record.calculatedAngle);
+        if (withBlobs)
+        {
+            out << "," << std::to_string(record.blueConeX) << "," << record.blueConeArea << "," << record.blueBlobs;
+            out << "," << std::to_string(record.yellowConeX) << "," << record.yellowConeArea << "," << record.yellowBlobs;
+        }
+        out << "\n";
+    }
+}
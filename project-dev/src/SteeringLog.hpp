@@ -0,0 +1,73 @@
+#ifndef STEERINGLOG
+#define STEERINGLOG
+
+#include "Frame.hpp"
+#include "SpscQueue.hpp"
+#include "SteeringModel.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <iosfwd>
+#include <string>
+#include <thread>
+#include <vector>
+
+// One fixed-size entry of the binary steering log. Written as is, so the file uses the byte order of
+// the machine that wrote it (little-endian on all our targets).
+struct SteeringRecord
+{
+    int64_t sampleTimeStamp; // microseconds
+    double calculatedAngle;
+    float groundSteering;
+    float blueConeX; // x of the cone used for steering, 0 if none
+    float yellowConeX;
+    int32_t blueConeArea; // pixels of the largest candidate, not necessarily the cone above
+    int32_t yellowConeArea;
+    uint16_t blueBlobs; // number of cone candidates
+    uint16_t yellowBlobs;
+};
+
+// Builds the log entry for a processed frame.
+SteeringRecord makeSteeringRecord(const Frame &frame);
+// The features a logged frame was steered with; the log only has the x of the cones, so their y is 0.
+SteeringFeatures makeSteeringFeatures(const SteeringRecord &record);
+
+// Writes steering records to a compact binary file without blocking the frame processing: log() only
+// pushes the record into a lock-free ring and a background thread writes the records in batches.
+// If the ring is full the record is dropped and counted instead of waiting for the disk.
+class SteeringLog
+{
+private:
+    std::ofstream m_file;
+    SpscQueue<SteeringRecord> m_ring;
+    std::atomic<bool> m_running;
+    std::atomic<uint64_t> m_dropped;
+    std::thread m_writer;
+
+    void write();
+
+public:
+    static const char MAGIC[8];
+    static const uint32_t VERSION = 1;
+
+    explicit SteeringLog(const std::string &fileName, size_t capacity = 4096);
+    // Writes the remaining records and closes the file.
+    ~SteeringLog();
+    SteeringLog(const SteeringLog &) = delete;
+    SteeringLog &operator=(const SteeringLog &) = delete;
+
+    bool isOpen() const { return m_file.is_open(); }
+    // Called from the frame processing thread.
+    void log(const SteeringRecord &record);
+    uint64_t dropped() const { return m_dropped.load(); }
+};
+
+// Reads a binary steering log; returns false if the file is missing or not a steering log.
+bool readSteeringLog(const std::string &fileName, std::vector<SteeringRecord> &records);
+
+// Writes the records in the CSV layout of the former per-frame log (timestamp, ground truth and
+// calculated angle), optionally followed by the blob statistics.
+void writeSteeringCsv(std::ostream &out, const std::vector<SteeringRecord> &records, bool withBlobs);
+
+#endif
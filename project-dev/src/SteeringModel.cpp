@@ -0,0 +1,16 @@
+#include "SteeringModel.hpp"
+
+SteeringFeatures makeSteeringFeatures(const Frame &frame)
+{
+    SteeringFeatures features{};
+    features.blueCone = frame.blueCone;
+    features.yellowCone = frame.yellowCone;
+    features.blueArea = frame.blueCandidates.empty() ? 0 : frame.blueCandidates.largest().area;
+    features.yellowArea = frame.yellowCandidates.empty() ? 0 : frame.yellowCandidates.largest().area;
+    features.blueBlobs = static_cast<uint16_t>(frame.blueCandidates.count);
+    features.yellowBlobs = static_cast<uint16_t>(frame.yellowCandidates.count);
+    features.tracked = frame.tracked;
+    features.blueVelocity = frame.blueVelocity;
+    features.yellowVelocity = frame.yellowVelocity;
+    return features;
+}
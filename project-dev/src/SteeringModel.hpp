@@ -0,0 +1,38 @@
+#ifndef STEERINGMODEL
+#define STEERINGMODEL
+
+#include "Frame.hpp"
+
+#include <opencv2/core/core.hpp>
+
+#include <cstdint>
+
+// What the cone detection found in a frame, as input of a steering model.
+struct SteeringFeatures
+{
+    cv::Point2f blueCone;   // the cone steered by: the selected candidate or its track, (0, 0) if none
+    cv::Point2f yellowCone;
+    // Pixels of the largest candidate, which need not be the cone above: the logs the polynomial models
+    // are fitted on record this area, so it does not follow the selection.
+    int32_t blueArea;
+    int32_t yellowArea;
+    uint16_t blueBlobs;     // number of cone candidates
+    uint16_t yellowBlobs;
+    bool tracked;             // the cones are tracked and these are their velocities (pixels per frame)
+    cv::Point2f blueVelocity;
+    cv::Point2f yellowVelocity;
+};
+
+SteeringFeatures makeSteeringFeatures(const Frame &frame);
+
+// Turns the features of consecutive frames into steering wheel angles. Models may keep state of the
+// previous frames, so frames must be passed in order.
+class SteeringModel
+{
+public:
+    virtual ~SteeringModel() = default;
+
+    virtual double estimate(const SteeringFeatures &features) = 0;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#include "SteeringOutput.hpp"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+SteeringOutput::SteeringOutput(std::ostream &out, const FlushPolicy &policy, size_t bufferSize)
+    : m_out(out), m_policy(policy), m_buffer(bufferSize), m_size{0}, m_pendingFrames{0},
+      m_lastFlush{std::chrono::steady_clock::now()}
+{
+}
+
+SteeringOutput::~SteeringOutput()
+{
+    flush();
+}
+
+void SteeringOutput::emit(int64_t sampleTimeStamp, double calculatedAngle)
+{
+    // std::to_string formats with %lld and %f.
+    char line[128];
+    const int length = std::snprintf(line, sizeof(line), "Group 15; %" PRId64 "; %f\n", sampleTimeStamp, calculatedAngle);
+    if (length < 0)
+    {
+        return;
+    }
+    if (static_cast<size_t>(length) >= sizeof(line))
+    {
+        // Only absurdly large angles get here.
+        flush();
+        m_out << "Group 15; " << std::to_string(sampleTimeStamp) << "; " << std::to_string(calculatedAngle) << "\n";
+    }
+    else
+    {
+        if (m_size + static_cast<size_t>(length) > m_buffer.size())
+        {
+            flush();
+        }
+        std::memcpy(m_buffer.data() + m_size, line, static_cast<size_t>(length));
+        m_size += static_cast<size_t>(length);
+    }
+    m_pendingFrames++;
+
+    if ((m_policy.frames > 0 && m_pendingFrames >= m_policy.frames) ||
+        (m_policy.interval.count() > 0 && std::chrono::steady_clock::now() - m_lastFlush >= m_policy.interval))
+    {
+        flush();
+    }
+}
+
+void SteeringOutput::flush()
+{
+    if (m_size > 0)
+    {
+        m_out.write(m_buffer.data(), static_cast<std::streamsize>(m_size));
+        m_size = 0;
+    }
+    m_out.flush();
+    m_pendingFrames = 0;
+    m_lastFlush = std::chrono::steady_clock::now();
+}
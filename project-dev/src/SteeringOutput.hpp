@@ -0,0 +1,43 @@
+#ifndef STEERINGOUTPUT
+#define STEERINGOUTPUT
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+// When the buffered steering lines are handed to the output stream. The buffer is flushed after every
+// `frames` lines and whenever `interval` has passed since the last flush; a zero disables the rule.
+// With both rules disabled the lines are written when the buffer is full and on exit.
+struct FlushPolicy
+{
+    size_t frames;
+    std::chrono::milliseconds interval;
+};
+
+// Buffered channel for the "Group 15; <timestamp>; <angle>" lines. The lines are formatted into a
+// preallocated buffer, so printing a frame neither allocates nor performs a system call unless the
+// flush policy asks for it. The text is the same as streaming std::to_string of both values.
+class SteeringOutput
+{
+private:
+    std::ostream &m_out;
+    FlushPolicy m_policy;
+    std::vector<char> m_buffer;
+    size_t m_size;
+    size_t m_pendingFrames;
+    std::chrono::steady_clock::time_point m_lastFlush;
+
+public:
+    SteeringOutput(std::ostream &out, const FlushPolicy &policy, size_t bufferSize = 64 * 1024);
+    // Writes what is still buffered.
+    ~SteeringOutput();
+    SteeringOutput(const SteeringOutput &) = delete;
+    SteeringOutput &operator=(const SteeringOutput &) = delete;
+
+    void emit(int64_t sampleTimeStamp, double calculatedAngle);
+    void flush();
+};
+
+#endif
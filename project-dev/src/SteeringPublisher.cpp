@@ -0,0 +1,114 @@
+#include "SteeringPublisher.hpp"
+
+#include "cluon-complete.hpp"
+#include "opendlv-standard-message-set.hpp"
+
+#include <cstring>
+
+const size_t GroundSteeringEncoder::MAX_PACKET_SIZE;
+
+namespace
+{
+// Wire types and field keys as written by cluon::ToProtoVisitor, which encodes every field, signed
+// integers as zig-zag varints, floats as four little-endian bytes and nested messages length-delimited.
+const uint8_t VARINT = 0;
+const uint8_t LENGTH_DELIMITED = 2;
+const uint8_t FOUR_BYTES = 5;
+
+uint8_t key(uint32_t field, uint8_t wireType)
+{
+    return static_cast<uint8_t>((field << 3) | wireType);
+}
+
+char *putVarInt(char *out, uint64_t v)
+{
+    while (v > 0x7f)
+    {
+        *out++ = static_cast<char>((v & 0x7f) | 0x80);
+        v >>= 7;
+    }
+    *out++ = static_cast<char>(v);
+    return out;
+}
+
+uint32_t zigZag(int32_t v)
+{
+    return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+// cluon::data::TimeStamp{seconds, microseconds} as a nested message, including its length.
+char *putTimeStamp(char *out, uint32_t field, int64_t microseconds)
+{
+    char body[16];
+    char *end = body;
+    *end++ = static_cast<char>(key(1, VARINT));
+    end = putVarInt(end, zigZag(static_cast<int32_t>(microseconds / 1000000)));
+    *end++ = static_cast<char>(key(2, VARINT));
+    end = putVarInt(end, zigZag(static_cast<int32_t>(microseconds % 1000000)));
+
+    *out++ = static_cast<char>(key(field, LENGTH_DELIMITED));
+    out = putVarInt(out, static_cast<uint64_t>(end - body));
+    std::memcpy(out, body, static_cast<size_t>(end - body));
+    return out + (end - body);
+}
+} // namespace
+
+GroundSteeringEncoder::GroundSteeringEncoder()
+    : m_packet{}
+{
+    m_packet.reserve(MAX_PACKET_SIZE);
+}
+
+std::string &GroundSteeringEncoder::encode(float groundSteering, int64_t sampleTimeStamp, int64_t sentTimeStamp, uint32_t senderStamp)
+{
+    // opendlv.proxy.GroundSteeringRequest{groundSteering}
+    char message[5];
+    message[0] = static_cast<char>(key(1, FOUR_BYTES));
+    uint32_t bits;
+    std::memcpy(&bits, &groundSteering, sizeof(bits));
+    for (int i = 0; i < 4; i++)
+    {
+        message[1 + i] = static_cast<char>((bits >> (8 * i)) & 0xff);
+    }
+
+    // cluon.data.Envelope{dataType, serializedData, sent, received, sampleTimeStamp, senderStamp}
+    char envelope[MAX_PACKET_SIZE];
+    char *end = envelope;
+    *end++ = static_cast<char>(key(1, VARINT));
+    end = putVarInt(end, zigZag(opendlv::proxy::GroundSteeringRequest::ID()));
+    *end++ = static_cast<char>(key(2, LENGTH_DELIMITED));
+    end = putVarInt(end, sizeof(message));
+    std::memcpy(end, message, sizeof(message));
+    end += sizeof(message);
+    end = putTimeStamp(end, 3, sentTimeStamp);
+    end = putTimeStamp(end, 4, 0);
+    end = putTimeStamp(end, 5, sampleTimeStamp != 0 ? sampleTimeStamp : sentTimeStamp);
+    *end++ = static_cast<char>(key(6, VARINT));
+    end = putVarInt(end, senderStamp);
+
+    // OD4 header: 0x0D 0xA4 followed by the envelope length as three little-endian bytes.
+    const size_t LENGTH = static_cast<size_t>(end - envelope);
+    const char HEADER[5] = {0x0D, static_cast<char>(0xA4), static_cast<char>(LENGTH & 0xff),
+                            static_cast<char>((LENGTH >> 8) & 0xff), static_cast<char>((LENGTH >> 16) & 0xff)};
+    // Stays within the reserved capacity.
+    m_packet.assign(HEADER, sizeof(HEADER));
+    m_packet.append(envelope, LENGTH);
+    return m_packet;
+}
+
+SteeringPublisher::SteeringPublisher(uint16_t cid, uint32_t senderStamp)
+    : m_sender{new cluon::UDPSender{"225.0.0." + std::to_string(cid), 12175}}, m_encoder{}, m_senderStamp{senderStamp}
+{
+}
+
+SteeringPublisher::~SteeringPublisher()
+{
+}
+
+void SteeringPublisher::publish(int64_t sampleTimeStamp, double calculatedAngle)
+{
+    std::string &packet = m_encoder.encode(static_cast<float>(calculatedAngle), sampleTimeStamp,
+                                           cluon::time::toMicroseconds(cluon::time::now()), m_senderStamp);
+    // UDPSender::send() only reads the packet, so the buffer is reused for the next frame.
+    m_sender->send(std::move(packet));
+}
@@ -0,0 +1,51 @@
+#ifndef STEERINGPUBLISHER
+#define STEERINGPUBLISHER
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace cluon
+{
+class UDPSender;
+}
+
+// Encodes a GroundSteeringRequest into a complete OD4 packet (header and envelope) in a preallocated
+// buffer. The bytes are the same that OD4Session::send() produces, but without the string streams and
+// temporary strings of the generic visitor, so encoding a frame does not allocate.
+class GroundSteeringEncoder
+{
+private:
+    std::string m_packet;
+
+public:
+    // Upper bound of the packet size: every varint at its longest.
+    static const size_t MAX_PACKET_SIZE = 128;
+
+    GroundSteeringEncoder();
+
+    // The timestamps are in microseconds. The packet stays valid until the next call.
+    std::string &encode(float groundSteering, int64_t sampleTimeStamp, int64_t sentTimeStamp, uint32_t senderStamp);
+};
+
+// Publishes the calculated steering angle as GroundSteeringRequest to the multicast group of an OD4
+// session, with the sample timestamp of the frame and our own sender stamp.
+class SteeringPublisher
+{
+private:
+    std::unique_ptr<cluon::UDPSender> m_sender;
+    GroundSteeringEncoder m_encoder;
+    uint32_t m_senderStamp;
+
+public:
+    SteeringPublisher(uint16_t cid, uint32_t senderStamp);
+    ~SteeringPublisher();
+    SteeringPublisher(const SteeringPublisher &) = delete;
+    SteeringPublisher &operator=(const SteeringPublisher &) = delete;
+
+    void publish(int64_t sampleTimeStamp, double calculatedAngle);
+    uint32_t senderStamp() const { return m_senderStamp; }
+};
+
+#endif
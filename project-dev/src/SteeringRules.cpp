@@ -0,0 +1,177 @@
+#include "SteeringRules.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+constexpr SteeringRule DefaultSteeringRules<SteeringDirection::CLOCKWISE>::RULES[];
+constexpr SteeringRule DefaultSteeringRules<SteeringDirection::COUNTER_CLOCKWISE>::RULES[];
+const size_t SteeringRuleSet::CAPACITY;
+const int SteeringRuleTable::BOUNDS;
+const int SteeringRuleTable::ZONES;
+
+namespace
+{
+const double INF = std::numeric_limits<double>::infinity();
+
+double boundValue(RuleBound bound, const SteeringThresholds &thresholds)
+{
+    switch (bound)
+    {
+    case RuleBound::NONE_BELOW:
+        return -INF;
+    case RuleBound::LEFT_EDGE:
+        return thresholds.leftEdge;
+    case RuleBound::LEFT:
+        return thresholds.leftThreshold;
+    case RuleBound::CAR:
+        return thresholds.carPosition;
+    case RuleBound::RIGHT:
+        return thresholds.rightThreshold;
+    case RuleBound::RIGHT_EDGE:
+        return thresholds.rightEdge;
+    case RuleBound::NONE_ABOVE:
+        return INF;
+    }
+    return INF;
+}
+
+int scaled(int position, uint32_t frameWidth)
+{
+    const int64_t WIDTH = static_cast<int64_t>(frameWidth);
+    return static_cast<int>((position * WIDTH + REFERENCE_FRAME_WIDTH / 2) / REFERENCE_FRAME_WIDTH);
+}
+
+bool parseBound(const std::string &name, RuleBound &bound)
+{
+    const std::pair<const char *, RuleBound> NAMES[] = {
+        {"-inf", RuleBound::NONE_BELOW}, {"left-edge", RuleBound::LEFT_EDGE}, {"left", RuleBound::LEFT},
+        {"car", RuleBound::CAR}, {"right", RuleBound::RIGHT}, {"right-edge", RuleBound::RIGHT_EDGE}, {"inf", RuleBound::NONE_ABOVE}};
+    for (const auto &entry : NAMES)
+    {
+        if (name == entry.first)
+        {
+            bound = entry.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+// The x of a cone in a zone is either exactly a bound (odd zones) or strictly between two neighbouring
+// bounds (even zones), so whether lower < x < upper holds is the same for every x of the zone.
+bool applies(double lower, double upper, int zone, const double *bounds, int boundCount)
+{
+    if (zone % 2 == 1)
+    {
+        const double X = bounds[zone / 2];
+        return lower < X && X < upper;
+    }
+    const double LOW = (zone == 0) ? -INF : bounds[zone / 2 - 1];
+    const double HIGH = (zone == 2 * boundCount) ? INF : bounds[zone / 2];
+    return lower <= LOW && HIGH <= upper;
+}
+} // namespace
+
+SteeringRules defaultSteeringRules()
+{
+    return SteeringRules{defaultSteeringRuleSet<SteeringDirection::CLOCKWISE>(), defaultSteeringRuleSet<SteeringDirection::COUNTER_CLOCKWISE>()};
+}
+
+SteeringThresholds scaledSteeringThresholds(const SteeringThresholds &thresholds, uint32_t frameWidth)
+{
+    return SteeringThresholds{scaled(thresholds.carPosition, frameWidth), scaled(thresholds.leftThreshold, frameWidth),
+                              scaled(thresholds.rightThreshold, frameWidth), scaled(thresholds.leftEdge, frameWidth),
+                              scaled(thresholds.rightEdge, frameWidth)};
+}
+
+bool readSteeringRules(std::istream &in, SteeringRules &rules, std::string &error)
+{
+    SteeringRules read{};
+    bool hasClockwise = false;
+    bool hasCounterClockwise = false;
+    std::string line;
+    for (int number = 1; std::getline(in, line); number++)
+    {
+        std::istringstream fields(line);
+        std::string direction;
+        if (!(fields >> direction) || direction[0] == '#')
+        {
+            continue;
+        }
+        std::string cone;
+        std::string lower;
+        std::string upper;
+        SteeringRule rule{};
+        std::string rest;
+        const bool COMPLETE = static_cast<bool>(fields >> cone >> lower >> upper >> rule.angle) && !(fields >> rest);
+        SteeringRuleSet *set = (direction == "clockwise") ? &read.clockwise : (direction == "counter-clockwise") ? &read.counterClockwise : nullptr;
+        if (!COMPLETE || set == nullptr || (cone != "blue" && cone != "yellow") || !parseBound(lower, rule.lower) || !parseBound(upper, rule.upper))
+        {
+            error = "line " + std::to_string(number) + " is not '<clockwise|counter-clockwise> <blue|yellow> <lower> <upper> <angle>'";
+            return false;
+        }
+        if (set->count == SteeringRuleSet::CAPACITY)
+        {
+            error = "line " + std::to_string(number) + ": more than " + std::to_string(SteeringRuleSet::CAPACITY) + " rules for " + direction;
+            return false;
+        }
+        rule.cone = (cone == "blue") ? RuleCone::BLUE : RuleCone::YELLOW;
+        set->rules[set->count++] = rule;
+        hasClockwise = hasClockwise || set == &read.clockwise;
+        hasCounterClockwise = hasCounterClockwise || set == &read.counterClockwise;
+    }
+    if (hasClockwise)
+    {
+        rules.clockwise = read.clockwise;
+    }
+    if (hasCounterClockwise)
+    {
+        rules.counterClockwise = read.counterClockwise;
+    }
+    return true;
+}
+
+bool loadSteeringRules(const std::string &fileName, SteeringRules &rules, std::string &error)
+{
+    std::ifstream in(fileName);
+    if (!in)
+    {
+        error = "cannot open " + fileName;
+        return false;
+    }
+    return readSteeringRules(in, rules, error);
+}
+
+SteeringRuleTable::SteeringRuleTable(const SteeringRuleSet &rules, const SteeringThresholds &thresholds)
+    : m_bounds{}, m_angles{}
+{
+    double bounds[BOUNDS] = {static_cast<double>(thresholds.leftEdge), static_cast<double>(thresholds.leftThreshold),
+                             static_cast<double>(thresholds.carPosition), static_cast<double>(thresholds.rightThreshold),
+                             static_cast<double>(thresholds.rightEdge)};
+    std::sort(bounds, bounds + BOUNDS);
+    const int COUNT = static_cast<int>(std::unique(bounds, bounds + BOUNDS) - bounds);
+    for (int i = 0; i < BOUNDS; i++)
+    {
+        m_bounds[static_cast<size_t>(i)] = (i < COUNT) ? static_cast<float>(bounds[i]) : std::numeric_limits<float>::infinity();
+    }
+
+    for (int blueZone = 0; blueZone <= 2 * COUNT; blueZone++)
+    {
+        for (int yellowZone = 0; yellowZone <= 2 * COUNT; yellowZone++)
+        {
+            double angle = 0.0;
+            for (const SteeringRule &rule : rules)
+            {
+                const int ZONE = (rule.cone == RuleCone::BLUE) ? blueZone : yellowZone;
+                if (applies(boundValue(rule.lower, thresholds), boundValue(rule.upper, thresholds), ZONE, bounds, COUNT))
+                {
+                    angle = rule.angle;
+                    break;
+                }
+            }
+            m_angles[static_cast<size_t>(blueZone * ZONES + yellowZone)] = angle;
+        }
+    }
+}
@@ -0,0 +1,179 @@
+#ifndef STEERINGRULES
+#define STEERINGRULES
+
+#include <opencv2/core/core.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+// Car's position and thresholds, for frames REFERENCE_FRAME_WIDTH pixels wide
+const int REFERENCE_FRAME_WIDTH = 640;
+const int CAR_POSITION = 240;
+const int LEFT_THRESHOLD = 120;
+const int RIGHT_THRESHOLD = 360;
+// Cones closer to the edges of the frame than these are not steered for.
+const int LEFT_EDGE_POSITION = 5;
+const int RIGHT_EDGE_POSITION = 480;
+
+// Horizontal positions (pixels) used by the steering rules.
+struct SteeringThresholds
+{
+    int carPosition;
+    int leftThreshold;
+    int rightThreshold;
+    int leftEdge{LEFT_EDGE_POSITION};
+    int rightEdge{RIGHT_EDGE_POSITION};
+};
+
+const SteeringThresholds DEFAULT_STEERING_THRESHOLDS{CAR_POSITION, LEFT_THRESHOLD, RIGHT_THRESHOLD, LEFT_EDGE_POSITION, RIGHT_EDGE_POSITION};
+
+// Thresholds for frames REFERENCE_FRAME_WIDTH pixels wide scaled to frames of another width, rounded to
+// the nearest pixel, so the zones cover the same fractions of the frame.
+SteeringThresholds scaledSteeringThresholds(const SteeringThresholds &thresholds, uint32_t frameWidth);
+
+enum class SteeringDirection
+{
+    CLOCKWISE,        // blue cones on the left
+    COUNTER_CLOCKWISE // yellow cones on the left
+};
+
+enum class RuleCone
+{
+    BLUE,
+    YELLOW
+};
+
+// The bounds a rule refers to, resolved with the steering thresholds.
+enum class RuleBound
+{
+    NONE_BELOW, // -infinity
+    LEFT_EDGE,
+    LEFT,
+    CAR,
+    RIGHT,
+    RIGHT_EDGE,
+    NONE_ABOVE // +infinity
+};
+
+// Steers with angle when lower < x < upper for the x of the cone. Rules are tried in order; the first one
+// that applies wins and 0 is steered when none does.
+struct SteeringRule
+{
+    RuleCone cone;
+    RuleBound lower;
+    RuleBound upper;
+    double angle;
+};
+
+// Fixed-capacity list of rules for one direction.
+struct SteeringRuleSet
+{
+    static const size_t CAPACITY = 16;
+    SteeringRule rules[CAPACITY];
+    size_t count;
+
+    const SteeringRule *begin() const { return rules; }
+    const SteeringRule *end() const { return rules + count; }
+};
+
+// The built-in rules per direction, as compile-time tables.
+template <SteeringDirection DIRECTION>
+struct DefaultSteeringRules;
+
+template <>
+struct DefaultSteeringRules<SteeringDirection::CLOCKWISE>
+{
+    static constexpr SteeringRule RULES[] = {
+        {RuleCone::BLUE, RuleBound::NONE_BELOW, RuleBound::LEFT, 0.0},  // | B |   |   | Y | no turn
+        {RuleCone::YELLOW, RuleBound::RIGHT, RuleBound::NONE_ABOVE, 0.0},
+        {RuleCone::BLUE, RuleBound::LEFT, RuleBound::CAR, -0.1},        // |   | B |   |   | turn right
+        {RuleCone::BLUE, RuleBound::CAR, RuleBound::RIGHT, -0.2},       // |   |   | B |   |
+        {RuleCone::BLUE, RuleBound::RIGHT, RuleBound::RIGHT_EDGE, -0.25}, // |   |   |   | B |
+        {RuleCone::YELLOW, RuleBound::CAR, RuleBound::RIGHT, 0.1},      // |   |   | Y |   | turn left
+        {RuleCone::YELLOW, RuleBound::LEFT, RuleBound::CAR, 0.2},       // |   | Y |   |   |
+        {RuleCone::YELLOW, RuleBound::LEFT_EDGE, RuleBound::LEFT, 0.25}, // | Y |   |   |   |
+    };
+};
+
+template <>
+struct DefaultSteeringRules<SteeringDirection::COUNTER_CLOCKWISE>
+{
+    static constexpr SteeringRule RULES[] = {
+        {RuleCone::YELLOW, RuleBound::NONE_BELOW, RuleBound::LEFT, 0.0}, // | Y |   |   | B | no turn
+        {RuleCone::BLUE, RuleBound::RIGHT, RuleBound::NONE_ABOVE, 0.0},
+        {RuleCone::YELLOW, RuleBound::LEFT, RuleBound::CAR, -0.1},       // |   | Y |   |   | turn right
+        {RuleCone::YELLOW, RuleBound::CAR, RuleBound::RIGHT, -0.2},      // |   |   | Y |   |
+        {RuleCone::YELLOW, RuleBound::RIGHT, RuleBound::RIGHT_EDGE, -0.25}, // |   |   |   | Y |
+        // Never applies since CAR > LEFT; kept from the if/else chain this table replaced, whose steering
+        // it reproduces, so a blue cone between CAR and RIGHT steers 0.
+        {RuleCone::BLUE, RuleBound::CAR, RuleBound::LEFT, 0.1},          // |   |   | B |   | turn left
+        {RuleCone::BLUE, RuleBound::LEFT, RuleBound::CAR, 0.2},          // |   | B |   |   |
+        {RuleCone::BLUE, RuleBound::LEFT_EDGE, RuleBound::LEFT, 0.25},   // | B |   |   |   |
+    };
+};
+
+template <SteeringDirection DIRECTION>
+SteeringRuleSet defaultSteeringRuleSet()
+{
+    SteeringRuleSet set{};
+    for (const SteeringRule &rule : DefaultSteeringRules<DIRECTION>::RULES)
+    {
+        set.rules[set.count++] = rule;
+    }
+    return set;
+}
+
+// The rules of both directions.
+struct SteeringRules
+{
+    SteeringRuleSet clockwise;
+    SteeringRuleSet counterClockwise;
+};
+
+SteeringRules defaultSteeringRules();
+
+// Reads rules, one per line: "<clockwise|counter-clockwise> <blue|yellow> <lower> <upper> <angle>" with the
+// bounds -inf, left-edge, left, car, right, right-edge or inf. Empty lines and lines starting with # are
+// skipped. The rules of a direction that appears in the input replace its rules in `rules`; on an invalid
+// line false is returned and `error` describes it.
+bool readSteeringRules(std::istream &in, SteeringRules &rules, std::string &error);
+bool loadSteeringRules(const std::string &fileName, SteeringRules &rules, std::string &error);
+
+// The rules of one direction compiled for the thresholds into a lookup table. The x of each cone is
+// quantised into zones by the bounds: below, at and above every bound, which is all the rules can tell
+// apart. The angle of every pair of zones is precomputed, so steering is a few comparisons and one load
+// instead of a chain of branches, and it neither allocates nor depends on the order of the rules.
+class SteeringRuleTable
+{
+public:
+    static const int BOUNDS = 5;
+    static const int ZONES = 2 * BOUNDS + 1;
+
+private:
+    // The distinct finite bounds in ascending order, padded with +infinity.
+    std::array<float, BOUNDS> m_bounds;
+    std::array<double, ZONES * ZONES> m_angles;
+
+    int zone(float x) const
+    {
+        int z = 0;
+        for (int i = 0; i < BOUNDS; i++)
+        {
+            z += static_cast<int>(x > m_bounds[i]) + static_cast<int>(x >= m_bounds[i]);
+        }
+        return z;
+    }
+
+public:
+    SteeringRuleTable(const SteeringRuleSet &rules, const SteeringThresholds &thresholds);
+
+    double angle(const cv::Point2f &blueCone, const cv::Point2f &yellowCone) const
+    {
+        return m_angles[static_cast<size_t>(zone(blueCone.x) * ZONES + zone(yellowCone.x))];
+    }
+};
+
+#endif
@@ -0,0 +1,46 @@
+#include "SyntheticScene.hpp"
+
+#include <algorithm>
+
+const int SyntheticScene::CONE_WIDTH;
+const int SyntheticScene::CONE_HEIGHT;
+
+namespace
+{
+const cv::Scalar BACKGROUND{90, 90, 90, 255};
+const cv::Scalar BLUE{200, 60, 20, 255};
+const cv::Scalar YELLOW{86, 186, 230, 255};
+
+// Pixels a cone moves per frame.
+const int SPEED = 4;
+
+// Draws a cone with its left edge at x and returns its centroid.
+cv::Point2f drawCone(cv::Mat &bgra, int x, int top, int bottom, const cv::Scalar &color)
+{
+    bgra(cv::Range(top, bottom), cv::Range(x, x + SyntheticScene::CONE_WIDTH)).setTo(color);
+    return cv::Point2f(static_cast<float>(x) + (SyntheticScene::CONE_WIDTH - 1) / 2.0f,
+                       static_cast<float>(top + bottom - 1) / 2.0f);
+}
+} // namespace
+
+SyntheticScene::SyntheticScene(uint32_t width, uint32_t height, const RegionOfInterest &roi)
+    : m_width{width}, m_height{height}, m_roi{roi.clampedTo(width, height)}
+{
+}
+
+void SyntheticScene::render(uint64_t frameNumber, cv::Mat &bgra, cv::Point2f &blueCone, cv::Point2f &yellowCone) const
+{
+    bgra.create(static_cast<int>(m_height), static_cast<int>(m_width), CV_8UC4);
+    bgra.setTo(BACKGROUND);
+
+    // The cones are centred vertically in the band and move from right to left, the yellow one half the
+    // band behind the blue one, and start over when they leave it.
+    const int TRACK = std::max(1, m_roi.width() - CONE_WIDTH);
+    const int TOP = std::max(m_roi.top, (m_roi.top + m_roi.bottom - CONE_HEIGHT) / 2);
+    const int BOTTOM = std::min(m_roi.bottom, TOP + CONE_HEIGHT);
+    const int OFFSET = static_cast<int>((frameNumber * SPEED) % static_cast<uint64_t>(TRACK));
+    const int BLUE_X = m_roi.left + TRACK - 1 - OFFSET;
+    const int YELLOW_X = m_roi.left + (2 * TRACK - 1 - OFFSET - TRACK / 2) % TRACK;
+    blueCone = drawCone(bgra, BLUE_X, TOP, BOTTOM, BLUE);
+    yellowCone = drawCone(bgra, YELLOW_X, TOP, BOTTOM, YELLOW);
+}
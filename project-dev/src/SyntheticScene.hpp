@@ -0,0 +1,31 @@
+#ifndef SYNTHETICSCENE
+#define SYNTHETICSCENE
+
+#include "FrameAcquisition.hpp"
+
+#include <opencv2/core/core.hpp>
+
+#include <cstdint>
+
+// Procedurally generated camera frames for load tests: a blue and a yellow cone drift across the band at
+// known positions on a grey background. The cone colours lie well inside the HSV ranges of ConeColors.hpp.
+class SyntheticScene
+{
+private:
+    uint32_t m_width;
+    uint32_t m_height;
+    RegionOfInterest m_roi;
+
+public:
+    // Cone size in pixels.
+    static const int CONE_WIDTH = 20;
+    static const int CONE_HEIGHT = 30;
+
+    SyntheticScene(uint32_t width, uint32_t height, const RegionOfInterest &roi);
+
+    // Renders frame number frameNumber into bgra (width x height, CV_8UC4) and returns the centroids of the
+    // cones, as the cone detection finds them.
+    void render(uint64_t frameNumber, cv::Mat &bgra, cv::Point2f &blueCone, cv::Point2f &yellowCone) const;
+};
+
+#endif
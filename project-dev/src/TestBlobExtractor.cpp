@@ -0,0 +1,102 @@
+#include "catch.hpp"
+#include "BlobExtractor.hpp"
+
+namespace
+{
+void fill(cv::Mat &mask, int top, int left, int height, int width)
+{
+    for (int row = top; row < top + height; row++)
+    {
+        for (int col = left; col < left + width; col++)
+        {
+            mask.at<uint8_t>(row, col) = 255;
+        }
+    }
+}
+} // namespace
+
+TEST_CASE("Blobs are returned sorted by area with their centroids.")
+{
+    cv::Mat mask = cv::Mat::zeros(50, 640, CV_8UC1);
+    fill(mask, 10, 100, 10, 10); // 100 pixels, centroid (104.5, 14.5)
+    fill(mask, 20, 400, 20, 20); // 400 pixels, centroid (409.5, 29.5)
+    fill(mask, 0, 600, 3, 3);    // too small
+
+    BlobExtractor extractor(640, 50);
+    const ConeCandidates cones = extractor.extract(mask, 75);
+    REQUIRE(cones.count == 2);
+    REQUIRE(cones.items[0].area == 400);
+    REQUIRE(cones.items[0].x == Approx(409.5f));
+    REQUIRE(cones.items[0].y == Approx(29.5f));
+    REQUIRE(cones.items[1].area == 100);
+    REQUIRE(cones.items[1].x == Approx(104.5f));
+    REQUIRE(cones.items[1].y == Approx(14.5f));
+    REQUIRE(cones.items[0].left == 400);
+    REQUIRE(cones.items[0].top == 20);
+    REQUIRE(cones.items[0].right == 420);
+    REQUIRE(cones.items[0].bottom == 40);
+    REQUIRE(cones.items[1].boundingBox().x == 100);
+    REQUIRE(cones.items[1].boundingBox().y == 10);
+    REQUIRE(cones.items[1].boundingBox().width == 10);
+    REQUIRE(cones.items[1].boundingBox().height == 10);
+}
+
+TEST_CASE("The nearest cone is the one reaching furthest down the band.")
+{
+    cv::Mat mask = cv::Mat::zeros(50, 640, CV_8UC1);
+    fill(mask, 0, 100, 20, 20);  // largest, far away
+    fill(mask, 35, 300, 10, 10); // small, close to the car
+    fill(mask, 30, 500, 15, 10); // as close, but larger
+
+    BlobExtractor extractor(640, 50);
+    const ConeCandidates cones = extractor.extract(mask, 75);
+    REQUIRE(cones.count == 3);
+    REQUIRE(cones.largest().x == Approx(109.5f));
+    REQUIRE(cones.nearest().x == Approx(504.5f));
+    REQUIRE(cones.selected(ConeSelection::LARGEST).x == Approx(109.5f));
+    REQUIRE(cones.selected(ConeSelection::NEAREST).x == Approx(504.5f));
+}
+
+TEST_CASE("Blobs are 8-connected and merged when two branches meet further down.")
+{
+    cv::Mat mask = cv::Mat::zeros(20, 40, CV_8UC1);
+    // A U shape: two separate columns that are joined by the bottom bar.
+    fill(mask, 0, 5, 10, 2);
+    fill(mask, 0, 20, 10, 2);
+    fill(mask, 10, 5, 2, 17);
+    // Diagonal neighbours belong to the same blob.
+    mask.at<uint8_t>(15, 30) = 255;
+    mask.at<uint8_t>(16, 31) = 255;
+    mask.at<uint8_t>(17, 30) = 255;
+
+    BlobExtractor extractor(40, 20);
+    const ConeCandidates cones = extractor.extract(mask, 0);
+    REQUIRE(cones.count == 2);
+    REQUIRE(cones.items[0].area == 10 * 2 + 10 * 2 + 2 * 17);
+    REQUIRE(cones.items[1].area == 3);
+    REQUIRE(cones.items[1].x == Approx(91.0f / 3.0f));
+    REQUIRE(cones.items[1].y == Approx(16.0f));
+    // The bounding box of the merged blob covers both branches.
+    REQUIRE(cones.items[0].left == 5);
+    REQUIRE(cones.items[0].right == 22);
+    REQUIRE(cones.items[0].top == 0);
+    REQUIRE(cones.items[0].bottom == 12);
+}
+
+TEST_CASE("Only the largest blobs are kept when there are more than fit.")
+{
+    cv::Mat mask = cv::Mat::zeros(10, 640, CV_8UC1);
+    for (int i = 0; i < 40; i++)
+    {
+        fill(mask, 0, i * 16, 1 + i % 10, 8);
+    }
+
+    BlobExtractor extractor(640, 10);
+    const ConeCandidates cones = extractor.extract(mask, 0);
+    REQUIRE(cones.count == ConeCandidates::CAPACITY);
+    for (size_t i = 1; i < cones.count; i++)
+    {
+        REQUIRE(cones.items[i - 1].area >= cones.items[i].area);
+    }
+    REQUIRE(cones.items[cones.count - 1].area == 8 * 7);
+}
@@ -0,0 +1,40 @@
+#include "catch.hpp"
+#include "CatchUpPolicy.hpp"
+
+TEST_CASE("The catch-up policies are parsed by name.")
+{
+    CatchUpPolicy policy{CatchUpPolicy::BACKLOG};
+    REQUIRE(parseCatchUpPolicy("latest", policy));
+    REQUIRE(policy == CatchUpPolicy::LATEST);
+    REQUIRE(parseCatchUpPolicy("degrade", policy));
+    REQUIRE(policy == CatchUpPolicy::DEGRADE);
+    REQUIRE(parseCatchUpPolicy("backlog", policy));
+    REQUIRE(policy == CatchUpPolicy::BACKLOG);
+    REQUIRE(!parseCatchUpPolicy("all", policy));
+    REQUIRE(policy == CatchUpPolicy::BACKLOG);
+    REQUIRE(std::string(catchUpPolicyName(CatchUpPolicy::LATEST)) == "latest");
+}
+
+TEST_CASE("Only the backlog policy queues frames between the stages.")
+{
+    REQUIRE(catchUpFrameSlots(CatchUpPolicy::LATEST, 4, 2) == 4);
+    REQUIRE(catchUpFrameSlots(CatchUpPolicy::DEGRADE, 4, 2) == 4);
+    REQUIRE(catchUpFrameSlots(CatchUpPolicy::BACKLOG, 4, 2) == 6);
+    REQUIRE(catchUpFrameSlots(CatchUpPolicy::LATEST, 0, 2) == 1);
+}
+
+TEST_CASE("Frames are degraded for a while after frames were dropped.")
+{
+    CatchUp catchUp{CatchUpPolicy::DEGRADE};
+    REQUIRE(!catchUp.degrade(1));
+    REQUIRE(catchUp.degrade(3));
+    for (uint32_t i = 1; i < CatchUp::DEGRADED_FRAMES; i++)
+    {
+        REQUIRE(catchUp.degrade(1));
+    }
+    REQUIRE(!catchUp.degrade(1));
+
+    CatchUp latest{CatchUpPolicy::LATEST};
+    REQUIRE(!latest.degrade(3));
+    REQUIRE(!latest.degrade(1));
+}
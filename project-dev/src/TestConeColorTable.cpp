@@ -0,0 +1,82 @@
+#include "catch.hpp"
+#include "ConeColorTable.hpp"
+#include "ConeSegmentation.hpp"
+
+#include <cstring>
+#include <random>
+
+namespace
+{
+cv::Mat randomImage(int rows, int cols, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    cv::Mat image(rows, cols, CV_8UC4);
+    for (size_t i = 0; i < image.total() * 4; i++)
+    {
+        image.data[i] = static_cast<uint8_t>(rng());
+    }
+    return image;
+}
+
+size_t countDifferences(const cv::Mat &a, const cv::Mat &b)
+{
+    size_t differences = 0;
+    for (size_t i = 0; i < a.total(); i++)
+    {
+        differences += (a.data[i] != b.data[i]) ? 1 : 0;
+    }
+    return differences;
+}
+} // namespace
+
+TEST_CASE("A lookup table with 8 bits per channel is exact.")
+{
+    const ConeColorTable table(BLUE_CONE_RANGE, YELLOW_CONE_RANGE, 8);
+    REQUIRE(table.sizeInBytes() > (1u << 22));
+
+    const cv::Mat image = randomImage(200, 640, 3);
+    cv::Mat expectedBlue, expectedYellow, blueMask, yellowMask;
+    segmentCones(image, BLUE_CONE_RANGE, YELLOW_CONE_RANGE, expectedBlue, expectedYellow);
+    table.segment(image, blueMask, yellowMask);
+    REQUIRE(countDifferences(expectedBlue, blueMask) == 0);
+    REQUIRE(countDifferences(expectedYellow, yellowMask) == 0);
+}
+
+TEST_CASE("A quantized lookup table classifies cell centres exactly and stays compact.")
+{
+    const ConeColorTable table(BLUE_CONE_RANGE, YELLOW_CONE_RANGE, 6);
+    REQUIRE(table.sizeInBytes() <= 64 * 1024 + 1);
+
+    // Pure cone-like colours sitting on cell centres.
+    cv::Mat image(1, 3, CV_8UC4);
+    const uint8_t pixels[] = {
+        190, 66, 34, 0,  // blue
+        86, 186, 230, 0, // yellow
+        130, 130, 130, 0 // grey
+    };
+    std::memcpy(image.data, pixels, sizeof(pixels));
+    cv::Mat expectedBlue, expectedYellow, blueMask, yellowMask;
+    segmentCones(image, BLUE_CONE_RANGE, YELLOW_CONE_RANGE, expectedBlue, expectedYellow);
+    table.segment(image, blueMask, yellowMask);
+    REQUIRE(countDifferences(expectedBlue, blueMask) == 0);
+    REQUIRE(countDifferences(expectedYellow, yellowMask) == 0);
+    REQUIRE(blueMask.data[0] == 255);
+    REQUIRE(yellowMask.data[1] == 255);
+    REQUIRE(blueMask.data[2] == 0);
+    REQUIRE(yellowMask.data[2] == 0);
+
+    // Quantization only changes colours close to the range borders.
+    const cv::Mat noise = randomImage(100, 640, 7);
+    segmentCones(noise, BLUE_CONE_RANGE, YELLOW_CONE_RANGE, expectedBlue, expectedYellow);
+    table.segment(noise, blueMask, yellowMask);
+    REQUIRE(countDifferences(expectedBlue, blueMask) < noise.total() / 50);
+    REQUIRE(countDifferences(expectedYellow, yellowMask) < noise.total() / 50);
+}
+
+TEST_CASE("Only 1 to 8 bits per channel are valid.")
+{
+    REQUIRE_FALSE(ConeColorTable::validBitsPerChannel(0));
+    REQUIRE(ConeColorTable::validBitsPerChannel(1));
+    REQUIRE(ConeColorTable::validBitsPerChannel(8));
+    REQUIRE_FALSE(ConeColorTable::validBitsPerChannel(9));
+}
@@ -0,0 +1,92 @@
+#include "catch.hpp"
+#include "ConeSegmentation.hpp"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+bool sameMask(const cv::Mat &a, const cv::Mat &b)
+{
+    if (a.rows != b.rows || a.cols != b.cols || a.type() != b.type())
+    {
+        return false;
+    }
+    for (int row = 0; row < a.rows; row++)
+    {
+        if (0 != std::memcmp(a.ptr<uint8_t>(row), b.ptr<uint8_t>(row), static_cast<size_t>(a.cols)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<SimdLevel> supportedLevels()
+{
+    std::vector<SimdLevel> levels{SimdLevel::SCALAR};
+    if (bestSimdLevel() != SimdLevel::SCALAR)
+    {
+        levels.push_back(SimdLevel::SSE41);
+    }
+    if (bestSimdLevel() == SimdLevel::AVX2)
+    {
+        levels.push_back(SimdLevel::AVX2);
+    }
+    return levels;
+}
+} // namespace
+
+TEST_CASE("Fused segmentation matches cvtColor and inRange for every BGR colour.")
+{
+    // One 256x256 slice of the colour cube per red value; alpha is set to garbage on purpose.
+    cv::Mat image(256, 256, CV_8UC4);
+    cv::Mat expectedBlue, expectedYellow, blueMask, yellowMask;
+    for (SimdLevel level : supportedLevels())
+    {
+        bool identical = true;
+        for (int r = 0; r < 256 && identical; r++)
+        {
+            for (int g = 0; g < 256; g++)
+            {
+                uint8_t *px = image.ptr<uint8_t>(g);
+                for (int b = 0; b < 256; b++)
+                {
+                    px[4 * b + 0] = static_cast<uint8_t>(b);
+                    px[4 * b + 1] = static_cast<uint8_t>(g);
+                    px[4 * b + 2] = static_cast<uint8_t>(r);
+                    px[4 * b + 3] = static_cast<uint8_t>(r ^ b);
+                }
+            }
+            segmentConesOpenCV(image, BLUE_CONE_RANGE, YELLOW_CONE_RANGE, expectedBlue, expectedYellow);
+            segmentCones(image, BLUE_CONE_RANGE, YELLOW_CONE_RANGE, blueMask, yellowMask, level);
+            identical = sameMask(expectedBlue, blueMask) && sameMask(expectedYellow, yellowMask);
+        }
+        REQUIRE(identical);
+    }
+}
+
+TEST_CASE("Fused segmentation handles image views and widths that are not a multiple of the vector size.")
+{
+    std::mt19937 rng(15);
+    cv::Mat frame(60, 643, CV_8UC4);
+    for (int row = 0; row < frame.rows; row++)
+    {
+        uint8_t *px = frame.ptr<uint8_t>(row);
+        for (int i = 0; i < frame.cols * 4; i++)
+        {
+            px[i] = static_cast<uint8_t>(rng());
+        }
+    }
+    const cv::Mat band = frame(cv::Range(5, 55), cv::Range(3, 640));
+
+    cv::Mat expectedBlue, expectedYellow, blueMask, yellowMask;
+    segmentConesOpenCV(band, BLUE_CONE_RANGE, YELLOW_CONE_RANGE, expectedBlue, expectedYellow);
+    for (SimdLevel level : supportedLevels())
+    {
+        segmentCones(band, BLUE_CONE_RANGE, YELLOW_CONE_RANGE, blueMask, yellowMask, level);
+        REQUIRE(sameMask(expectedBlue, blueMask));
+        REQUIRE(sameMask(expectedYellow, yellowMask));
+    }
+}
@@ -0,0 +1,162 @@
+#include "catch.hpp"
+#include "AllocationCounter.hpp"
+#include "ConeTracker.hpp"
+#include "SteeringEstimator.hpp"
+
+namespace
+{
+ConeCandidates candidatesAt(std::initializer_list<ConeCandidate> cones)
+{
+    ConeCandidates candidates{};
+    for (const ConeCandidate &cone : cones)
+    {
+        candidates.items[candidates.count++] = cone;
+    }
+    return candidates;
+}
+
+SteeringFeatures trackedFeatures(const TrackedCone &blue, const TrackedCone &yellow)
+{
+    return SteeringFeatures{blue.position, yellow.position, 100, 100, 1, 1, true, blue.velocity, yellow.velocity};
+}
+} // namespace
+
+TEST_CASE("A cone moving at constant speed is tracked with its velocity.")
+{
+    ConeTracker tracker;
+    TrackedCone cone{};
+    for (int frame = 0; frame < 30; frame++)
+    {
+        cone = tracker.update(candidatesAt({ConeCandidate{100, 300.0f - 4.0f * static_cast<float>(frame), 20.0f, 0, 0, 0, 0}}));
+        REQUIRE(cone.confirmed == (frame + 1 >= ConeTracker::CONFIRM_HITS));
+    }
+    REQUIRE(cone.position.x == Approx(300.0f - 4.0f * 29).margin(0.5));
+    REQUIRE(cone.position.y == Approx(20.0f).margin(0.01));
+    REQUIRE(cone.velocity.x == Approx(-4.0f).margin(0.1));
+}
+
+TEST_CASE("A single noisy frame moves the tracked cone only partly and keeps its direction.")
+{
+    ConeTracker tracker;
+    for (int frame = 0; frame < 20; frame++)
+    {
+        tracker.update(candidatesAt({ConeCandidate{100, 300.0f - 2.0f * static_cast<float>(frame), 20.0f, 0, 0, 0, 0}}));
+    }
+    // Expected at 260, measured 8 pixels to the right.
+    const TrackedCone NOISY = tracker.update(candidatesAt({ConeCandidate{100, 268.0f, 20.0f, 0, 0, 0, 0}}));
+    REQUIRE(NOISY.position.x < 260.0f + ConeTracker::ALPHA * 8.0f + 0.5f);
+    REQUIRE(NOISY.velocity.x < 0.0f);
+}
+
+TEST_CASE("Candidates outside the gate start a new track while the old one coasts.")
+{
+    ConeTracker tracker;
+    for (int frame = 0; frame < 5; frame++)
+    {
+        tracker.update(candidatesAt({ConeCandidate{100, 200.0f, 20.0f, 0, 0, 0, 0}}));
+    }
+    // A larger blob far away is reported, but as a new, unconfirmed track.
+    const TrackedCone JUMP = tracker.update(candidatesAt({ConeCandidate{300, 500.0f, 20.0f, 0, 0, 0, 0}, ConeCandidate{100, 201.0f, 20.0f, 0, 0, 0, 0}}));
+    REQUIRE(JUMP.position.x == Approx(500.0f));
+    REQUIRE_FALSE(JUMP.confirmed);
+
+    // Without candidates the confirmed track coasts for MAX_MISSES frames, then the cone is lost.
+    for (int miss = 1; miss <= ConeTracker::MAX_MISSES; miss++)
+    {
+        const TrackedCone COASTING = tracker.update(ConeCandidates{});
+        REQUIRE(COASTING.confirmed);
+        REQUIRE(COASTING.position.x == Approx(200.0f).margin(2.0));
+    }
+    const TrackedCone LOST = tracker.update(ConeCandidates{});
+    REQUIRE(LOST.position.x == Approx(0.0f));
+    REQUIRE_FALSE(LOST.confirmed);
+}
+
+TEST_CASE("The track of the selected candidate is reported.")
+{
+    ConeTracker tracker;
+    const ConeCandidates CANDIDATES = candidatesAt({ConeCandidate{300, 100.0f, 10.0f, 90, 0, 110, 20},
+                                                    ConeCandidate{100, 400.0f, 40.0f, 395, 35, 405, 45}});
+    REQUIRE(tracker.update(CANDIDATES, ConeSelection::LARGEST).position.x == Approx(100.0f));
+    REQUIRE(tracker.update(CANDIDATES, ConeSelection::NEAREST).position.x == Approx(400.0f));
+}
+
+TEST_CASE("The nearest cone is tracked even when it is the smallest of more candidates than tracks.")
+{
+    // Five larger blobs high up in the band and the nearest cone, the smallest, reaching furthest down.
+    const auto candidates = [](bool withNearest)
+    {
+        ConeCandidates result{};
+        for (int i = 0; i < 5; i++)
+        {
+            const float X = 100.0f * static_cast<float>(i + 1);
+            const int LEFT = static_cast<int>(X) - 10;
+            result.items[result.count++] = ConeCandidate{500 - 10 * i, X, 10.0f, LEFT, 0, LEFT + 20, 20};
+        }
+        if (withNearest)
+        {
+            result.items[result.count++] = ConeCandidate{80, 550.0f, 40.0f, 545, 35, 555, 48};
+        }
+        return result;
+    };
+
+    ConeTracker fresh;
+    const TrackedCone FIRST = fresh.update(candidates(true), ConeSelection::NEAREST);
+    REQUIRE(FIRST.position.x == Approx(550.0f));
+
+    // All tracks follow the larger blobs when the nearest cone appears outside the gate of every one.
+    ConeTracker busy;
+    for (int frame = 0; frame < 5; frame++)
+    {
+        busy.update(candidates(false), ConeSelection::NEAREST);
+    }
+    for (int frame = 0; frame < 5; frame++)
+    {
+        const TrackedCone NEAREST = busy.update(candidates(true), ConeSelection::NEAREST);
+        REQUIRE(NEAREST.position.x == Approx(550.0f));
+        REQUIRE(NEAREST.position.y == Approx(40.0f));
+        REQUIRE(NEAREST.confirmed == (frame + 1 >= ConeTracker::CONFIRM_HITS));
+    }
+}
+
+TEST_CASE("Tracking does not allocate.")
+{
+    ConeCandidates candidates{};
+    for (size_t i = 0; i < ConeCandidates::CAPACITY; i++)
+    {
+        candidates.items[candidates.count++] = ConeCandidate{static_cast<int>(500 - i), 30.0f * static_cast<float>(i + 1), 20.0f, 0, 0, 0, 0};
+    }
+    FrameConeTracker tracker;
+    Frame frame;
+    frame.blueCandidates = candidates;
+    frame.yellowCandidates = candidates;
+
+    const uint64_t BEFORE = allocationCount();
+    for (int i = 0; i < 100; i++)
+    {
+        tracker.track(frame);
+    }
+    REQUIRE(allocationCount() == BEFORE);
+    REQUIRE(frame.tracked);
+    REQUIRE(frame.blueCone.x > 0.0f);
+}
+
+TEST_CASE("A noisy frame does not flip the direction of the steering with tracked cones.")
+{
+    ConeTracker blueTracker;
+    ConeTracker yellowTracker;
+    SteeringEstimator tracked;
+    SteeringEstimator raw;
+    // Blue cone drifting to the left between the left threshold and the car: clockwise, turn right.
+    for (int frame = 0; frame < 10; frame++)
+    {
+        const ConeCandidates BLUE = candidatesAt({ConeCandidate{100, 220.0f - 3.0f * static_cast<float>(frame), 20.0f, 0, 0, 0, 0}});
+        tracked.estimate(trackedFeatures(blueTracker.update(BLUE), yellowTracker.update(ConeCandidates{})));
+        raw.estimate(BLUE.largest().centroid(), cv::Point2f());
+    }
+    // For one frame the cone is detected 10 pixels right of where it is expected.
+    const ConeCandidates NOISY = candidatesAt({ConeCandidate{100, 200.0f, 20.0f, 0, 0, 0, 0}});
+    REQUIRE(tracked.estimate(trackedFeatures(blueTracker.update(NOISY), yellowTracker.update(ConeCandidates{}))) == Approx(-0.1));
+    // Comparing raw positions flips to the counter-clockwise rules, which do not steer without a yellow cone.
+    REQUIRE(raw.estimate(NOISY.largest().centroid(), cv::Point2f()) == Approx(0.0));
+}
@@ -0,0 +1,20 @@
+#include "catch.hpp"
+#include "Evaluation.hpp"
+
+TEST_CASE("Angles strictly within the tolerance of the ground truth are correct.")
+{
+    REQUIRE(isCorrectAngle(0.0, 0.0));
+    REQUIRE(isCorrectAngle(0.24, 0.2));
+    REQUIRE(isCorrectAngle(-0.16, -0.2));
+    REQUIRE_FALSE(isCorrectAngle(0.3, 0.2));
+    REQUIRE_FALSE(isCorrectAngle(-0.1, 0.0));
+}
+
+TEST_CASE("Missing recordings are reported as invalid.")
+{
+    const EvaluationSettings SETTINGS{640, 480, RegionOfInterest{310, 360, 0, 640}, ProcessingSettings{false, 6, 1, ConeSelection::LARGEST, true, false, false, defaultSteeringRules(), false, PolynomialSteeringParameters{}}};
+    const EvaluationResult RESULT = evaluateRecording("does-not-exist.rec", SETTINGS);
+    REQUIRE_FALSE(RESULT.valid);
+    REQUIRE(RESULT.frames == 0);
+    REQUIRE(RESULT.accuracy() == Approx(0.0));
+}
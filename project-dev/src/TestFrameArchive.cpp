@@ -0,0 +1,103 @@
+#include "catch.hpp"
+#include "FrameArchive.hpp"
+
+#include <cstdio>
+#include <string>
+
+namespace
+{
+// A frame whose pixels encode their position and the frame number.
+cv::Mat testFrame(int width, int height, int number)
+{
+    cv::Mat frame(height, width, CV_8UC4);
+    for (int row = 0; row < height; row++)
+    {
+        for (int col = 0; col < width; col++)
+        {
+            uint8_t *pixel = frame.ptr(row) + col * 4;
+            pixel[0] = static_cast<uint8_t>(row);
+            pixel[1] = static_cast<uint8_t>(col);
+            pixel[2] = static_cast<uint8_t>(number);
+            pixel[3] = 255;
+        }
+    }
+    return frame;
+}
+} // namespace
+
+TEST_CASE("Full frames are replayed from the archive with their timestamps and ground truth.")
+{
+    const std::string FILE_NAME{"TestFrameArchive.archive"};
+    const int WIDTH = 40;
+    const int HEIGHT = 30;
+    {
+        FrameArchiveWriter writer(FILE_NAME, WIDTH, HEIGHT, RegionOfInterest{0, HEIGHT, 0, WIDTH});
+        REQUIRE(writer.isOpen());
+        for (int i = 0; i < 3; i++)
+        {
+            writer.append(testFrame(WIDTH, HEIGHT, i), 1000 + i, 0.1f * static_cast<float>(i));
+        }
+        REQUIRE(writer.frames() == 3);
+    }
+
+    FrameArchive archive(FILE_NAME);
+    std::remove(FILE_NAME.c_str());
+    REQUIRE(archive.valid());
+    REQUIRE(archive.frameCount() == 3);
+    REQUIRE(archive.frameWidth() == WIDTH);
+    REQUIRE(archive.frameHeight() == HEIGHT);
+
+    const RegionOfInterest BAND{10, 20, 5, 35};
+    Frame frame;
+    archive.read(2, BAND, frame);
+    REQUIRE(frame.sampleTimeStamp == 1002);
+    REQUIRE(frame.groundSteering == Approx(0.2f));
+    REQUIRE(frame.image.cols == WIDTH);
+    REQUIRE(frame.band.rows == 10);
+    REQUIRE(frame.band.cols == 30);
+    // The band is a view into the frame, which is a view into the mapping.
+    REQUIRE(frame.band.data == frame.image.ptr(10) + 5 * 4);
+    REQUIRE(frame.band.ptr(3)[0] == 13);
+    REQUIRE(frame.band.ptr(3)[4 * 7 + 1] == 12);
+    REQUIRE(frame.band.ptr(3)[2] == 2);
+}
+
+TEST_CASE("An archive of bands keeps the frame coordinates and ignores an incomplete last frame.")
+{
+    const std::string FILE_NAME{"TestFrameArchiveBand.archive"};
+    const int WIDTH = 40;
+    const int HEIGHT = 30;
+    const RegionOfInterest BAND{12, 18, 0, WIDTH};
+    {
+        FrameArchiveWriter writer(FILE_NAME, WIDTH, HEIGHT, BAND);
+        const cv::Mat IMAGE = testFrame(WIDTH, HEIGHT, 7);
+        writer.append(IMAGE(cv::Range(BAND.top, BAND.bottom), cv::Range(BAND.left, BAND.right)), 5, -0.25f);
+    }
+    {
+        // Half a frame, as if the recorder had been killed.
+        std::FILE *file = std::fopen(FILE_NAME.c_str(), "ab");
+        const char GARBAGE[100]{};
+        std::fwrite(GARBAGE, 1, sizeof(GARBAGE), file);
+        std::fclose(file);
+    }
+
+    FrameArchive archive(FILE_NAME);
+    std::remove(FILE_NAME.c_str());
+    REQUIRE(archive.valid());
+    REQUIRE(archive.frameCount() == 1);
+    REQUIRE(archive.region().top == 12);
+
+    Frame frame;
+    archive.read(0, RegionOfInterest{14, 16, 0, WIDTH}, frame);
+    REQUIRE(frame.groundSteering == Approx(-0.25f));
+    REQUIRE(frame.band.rows == 2);
+    REQUIRE(frame.band.ptr(0)[0] == 14);
+    REQUIRE(frame.band.ptr(1)[2] == 7);
+}
+
+TEST_CASE("Other files are not frame archives.")
+{
+    FrameArchive archive("does-not-exist.archive");
+    REQUIRE_FALSE(archive.valid());
+    REQUIRE(archive.frameCount() == 0);
+}
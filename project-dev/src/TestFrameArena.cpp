@@ -0,0 +1,64 @@
+#include "catch.hpp"
+#include "BlobExtractor.hpp"
+#include "FrameArena.hpp"
+
+#include <cstdint>
+#include <new>
+
+TEST_CASE("The frame arena hands out aligned storage until it is reset.")
+{
+    FrameArena arena(64);
+    uint8_t *bytes = arena.allocate<uint8_t>(3);
+    int64_t *words = arena.allocate<int64_t>(2);
+    REQUIRE(reinterpret_cast<uintptr_t>(words) % alignof(int64_t) == 0);
+    REQUIRE(reinterpret_cast<uint8_t *>(words) >= bytes + 3);
+    REQUIRE(arena.used() == 8 + 2 * sizeof(int64_t));
+    REQUIRE_THROWS_AS(arena.allocate<int64_t>(6), std::bad_alloc);
+
+    arena.reset();
+    REQUIRE(arena.used() == 0);
+    REQUIRE(arena.allocate<uint8_t>(3) == bytes);
+    REQUIRE(arena.allocate<int64_t>(7) != nullptr);
+    REQUIRE(arena.highWater() == 64);
+}
+
+TEST_CASE("Blobs extracted with the scratch of a frame arena are the same.")
+{
+    cv::Mat mask = cv::Mat::zeros(50, 640, CV_8UC1);
+    for (int row = 5; row < 45; row++)
+    {
+        for (int col = 0; col < 640; col += (row % 7) + 2)
+        {
+            mask.at<uint8_t>(row, col) = 255;
+        }
+    }
+    RunLengthMask encoded;
+    encoded.assign(mask);
+
+    BlobExtractor extractor(640, 50);
+    FrameArena arena(BlobExtractor::scratchSize(640, 50));
+    const ConeCandidates expected = extractor.extract(encoded, 0);
+    const ConeCandidates actual = extractor.extract(encoded, 0, arena);
+    REQUIRE(arena.used() > 0);
+    REQUIRE(actual.count == expected.count);
+    for (size_t i = 0; i < actual.count; i++)
+    {
+        REQUIRE(actual.items[i].area == expected.items[i].area);
+        REQUIRE(actual.items[i].x == Approx(expected.items[i].x));
+        REQUIRE(actual.items[i].y == Approx(expected.items[i].y));
+    }
+}
+
+TEST_CASE("A mask larger than expected still fits the scratch of the extractor.")
+{
+    cv::Mat mask = cv::Mat::zeros(100, 100, CV_8UC1);
+    for (int row = 0; row < 100; row += 2)
+    {
+        for (int col = 0; col < 100; col += 2)
+        {
+            mask.at<uint8_t>(row, col) = 255;
+        }
+    }
+    BlobExtractor extractor(10, 10);
+    REQUIRE(extractor.extract(mask, 0).count == ConeCandidates::CAPACITY);
+}
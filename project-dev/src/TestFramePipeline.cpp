@@ -0,0 +1,81 @@
+#include "catch.hpp"
+#include "FramePipeline.hpp"
+#include "SpscQueue.hpp"
+
+#include <thread>
+#include <vector>
+
+TEST_CASE("A SPSC queue is bounded and keeps the order across threads.")
+{
+    SpscQueue<int> queue(5);
+    REQUIRE(queue.capacity() == 8);
+    for (int i = 0; i < 8; i++)
+    {
+        REQUIRE(queue.tryPush(i));
+    }
+    REQUIRE_FALSE(queue.tryPush(8));
+    int item = -1;
+    REQUIRE(queue.tryPop(item));
+    REQUIRE(item == 0);
+
+    SpscQueue<int> channel(4);
+    const int COUNT = 100000;
+    std::vector<int> received;
+    std::thread consumer([&channel, &received, COUNT]() {
+        for (int i = 0; i < COUNT; i++)
+        {
+            received.push_back(channel.pop());
+        }
+    });
+    for (int i = 0; i < COUNT; i++)
+    {
+        channel.push(i);
+    }
+    consumer.join();
+    REQUIRE(received.size() == static_cast<size_t>(COUNT));
+    bool ordered = true;
+    for (int i = 0; i < COUNT; i++)
+    {
+        ordered = ordered && received[static_cast<size_t>(i)] == i;
+    }
+    REQUIRE(ordered);
+}
+
+TEST_CASE("Threaded and serial pipelines pass every frame through all stages in order.")
+{
+    for (bool threaded : {false, true})
+    {
+        const int64_t FRAMES = 2000;
+        int64_t acquired = 0;
+        std::vector<int64_t> emitted;
+        bool stagesInOrder = true;
+
+        FramePipeline pipeline(
+            [&acquired, FRAMES](Frame &frame) {
+                if (acquired == FRAMES)
+                {
+                    return false;
+                }
+                frame.sampleTimeStamp = ++acquired * 1000;
+                frame.calculatedAngle = 0.0;
+                return true;
+            },
+            {[](Frame &frame) { frame.calculatedAngle += 1.0; },
+             [](Frame &frame) { frame.calculatedAngle *= 10.0; },
+             [&emitted, &stagesInOrder](Frame &frame) {
+                 stagesInOrder = stagesInOrder && frame.calculatedAngle > 9.5 && frame.calculatedAngle < 10.5;
+                 emitted.push_back(frame.sampleTimeStamp);
+             }},
+            4);
+        pipeline.run(threaded);
+
+        REQUIRE(stagesInOrder);
+        REQUIRE(emitted.size() == static_cast<size_t>(FRAMES));
+        bool ordered = true;
+        for (size_t i = 0; i < emitted.size(); i++)
+        {
+            ordered = ordered && emitted[i] == static_cast<int64_t>(i + 1) * 1000;
+        }
+        REQUIRE(ordered);
+    }
+}
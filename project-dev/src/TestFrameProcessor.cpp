@@ -0,0 +1,58 @@
+#include "catch.hpp"
+#include "FrameProcessor.hpp"
+#include "SteeringEstimator.hpp"
+#include "SyntheticScene.hpp"
+
+TEST_CASE("The processor steers like the detector, tracker and estimator chained by hand.")
+{
+    const RegionOfInterest ROI{310, 360, 0, 640};
+    SyntheticScene scene{640, 480, ROI};
+    const ProcessingSettings SETTINGS{false, 6, 1, ConeSelection::NEAREST, true, false, false, defaultSteeringRules(), false, PolynomialSteeringParameters{}};
+    FrameProcessor processor{ROI, SETTINGS, std::unique_ptr<SteeringModel>{new SteeringEstimator{}}};
+    ConeDetector detector{ROI.width(), ROI.height(), false, 6, false, 1, ConeSelection::NEAREST};
+    FrameConeTracker tracker{ConeSelection::NEAREST};
+    SteeringEstimator estimator;
+    cv::Mat image;
+    Frame frame;
+    Frame reference;
+    for (uint64_t number = 0; number < 40; number++)
+    {
+        cv::Point2f blueCone;
+        cv::Point2f yellowCone;
+        scene.render(number, image, blueCone, yellowCone);
+        frame.band = image(cv::Range(ROI.top, ROI.bottom), cv::Range(ROI.left, ROI.right));
+        processor.segment(frame);
+        processor.detect(frame);
+        processor.estimate(frame);
+
+        reference.band = frame.band;
+        detector.segment(reference);
+        detector.detect(reference);
+        tracker.track(reference);
+        reference.calculatedAngle = estimator.estimate(makeSteeringFeatures(reference));
+
+        REQUIRE(frame.tracked == reference.tracked);
+        REQUIRE(frame.blueCone.x == Approx(reference.blueCone.x));
+        REQUIRE(frame.yellowCone.x == Approx(reference.yellowCone.x));
+        REQUIRE(frame.calculatedAngle == Approx(reference.calculatedAngle));
+    }
+}
+
+TEST_CASE("The settings choose between the steering rules and the polynomial model.")
+{
+    ProcessingSettings settings{false, 6, 1, ConeSelection::LARGEST, true, false, false, defaultSteeringRules(), false, PolynomialSteeringParameters{}};
+    // A blue cone between the left threshold and the car moving left, i.e. clockwise.
+    SteeringFeatures features{};
+    features.blueCone = cv::Point2f(200.0f, 10.0f);
+    features.tracked = true;
+    features.blueVelocity = cv::Point2f(-4.0f, 0.0f);
+    REQUIRE(makeSteeringModel(settings, 640)->estimate(features) == Approx(-0.1));
+    settings.rules.clockwise.rules[2].angle = -0.15;
+    REQUIRE(makeSteeringModel(settings, 640)->estimate(features) == Approx(-0.15));
+
+    settings.polynomialModel = true;
+    settings.modelParameters.weights[0] = 0.3f;
+    settings.modelParameters.minAngle = -1.0f;
+    settings.modelParameters.maxAngle = 1.0f;
+    REQUIRE(makeSteeringModel(settings, 640)->estimate(features) == Approx(0.3));
+}
@@ -0,0 +1,77 @@
+#include "catch.hpp"
+#include "FrameTiming.hpp"
+
+TEST_CASE("Consecutive frames are one period apart.")
+{
+    FrameTiming timing{33333};
+    REQUIRE(timing.next(1000000) == 1);
+    REQUIRE(timing.next(1033333) == 1);
+    // Jitter of the producer is rounded away
+    REQUIRE(timing.next(1070000) == 1);
+    REQUIRE(timing.next(1100000) == 1);
+}
+
+TEST_CASE("Gaps in the timestamps count the missed frames.")
+{
+    FrameTiming timing{33333};
+    REQUIRE(timing.next(0) == 1);
+    REQUIRE(timing.next(100000) == 3);
+    REQUIRE(timing.next(133333) == 1);
+}
+
+TEST_CASE("The same timestamp again is a repeated frame.")
+{
+    FrameTiming timing{33333};
+    REQUIRE(timing.next(500) == 1);
+    REQUIRE(timing.next(500) == 0);
+    REQUIRE(timing.next(33833) == 1);
+}
+
+TEST_CASE("Timestamps jumping backwards start over from the new frame.")
+{
+    FrameTiming timing;
+    REQUIRE(timing.next(1000000) == 1);
+    REQUIRE(timing.next(1050000) == 1);
+    // The producer restarted: the frame is processed and the following ones are not repeats.
+    REQUIRE(timing.next(400) == 1);
+    REQUIRE(timing.next(400) == 0);
+    REQUIRE(timing.next(25400) == 1);
+    REQUIRE(timing.period() == 25000);
+    REQUIRE(timing.next(50400) == 1);
+}
+
+TEST_CASE("The frame period is learned as the median of the first gaps.")
+{
+    FrameTiming timing;
+    REQUIRE(timing.next(0) == 1);
+    REQUIRE(timing.next(50000) == 1);
+    REQUIRE(timing.period() == 50000);
+    REQUIRE(timing.next(75000) == 1);
+    REQUIRE(timing.period() == 50000);
+    REQUIRE(timing.next(100000) == 1);
+    REQUIRE(timing.period() == 25000);
+    REQUIRE(timing.next(125000) == 1);
+    // Missed frames while learning are outnumbered by the regular gaps.
+    REQUIRE(timing.next(225000) == 4);
+    REQUIRE(timing.period() == 25000);
+}
+
+TEST_CASE("A jittery pair of frames while learning does not shrink the period.")
+{
+    FrameTiming timing;
+    int64_t stamp = 0;
+    REQUIRE(timing.next(stamp) == 1);
+    // The second frame was published late, the third on time.
+    REQUIRE(timing.next(stamp += 45000) == 1);
+    REQUIRE(timing.next(stamp += 5000) == 1);
+    for (size_t i = 0; i < FrameTiming::LEARNING_GAPS; i++)
+    {
+        REQUIRE(timing.next(stamp += 25000) == 1);
+    }
+    REQUIRE(timing.period() == 25000);
+    // A later jittery pair neither changes the period nor counts as missed frames.
+    REQUIRE(timing.next(stamp += 35000) == 1);
+    REQUIRE(timing.next(stamp += 15000) == 1);
+    REQUIRE(timing.period() == 25000);
+    REQUIRE(timing.next(stamp += 75000) == 3);
+}
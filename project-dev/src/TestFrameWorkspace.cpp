@@ -0,0 +1,130 @@
+#include "catch.hpp"
+#include "AllocationCounter.hpp"
+#include "ConeDetector.hpp"
+#include "FrameAcquisition.hpp"
+#include "FramePipeline.hpp"
+#include "FrameWorkspace.hpp"
+#include "SteeringEstimator.hpp"
+#include "SteeringOutput.hpp"
+#include "SteeringPublisher.hpp"
+#include "SyntheticScene.hpp"
+
+#include <sstream>
+
+namespace
+{
+// Runs frames of the synthetic scene through the stages and returns the allocations after the first
+// frames, which may still size buffers on first use.
+uint64_t steadyStateAllocations(bool fullFrame, size_t detectionThreads, bool degraded)
+{
+    const uint32_t WIDTH = 640;
+    const uint32_t HEIGHT = 480;
+    const RegionOfInterest ROI{310, 360, 0, 640};
+    const FrameAcquisition ACQUISITION{WIDTH, HEIGHT, ROI, fullFrame};
+    SyntheticScene scene{WIDTH, HEIGHT, ROI};
+    ConeDetector detector{ROI.width(), ROI.height(), false, 6, false, detectionThreads};
+    SteeringEstimator estimator;
+    std::ostringstream out;
+    SteeringOutput output{out, FlushPolicy{0, std::chrono::milliseconds(0)}};
+    GroundSteeringEncoder encoder;
+
+    // The scene is rendered up front as rendering is not part of the processing.
+    const uint64_t FRAMES = 100;
+    const uint64_t WARM_UP = 3;
+    std::vector<cv::Mat> images(8);
+    for (size_t i = 0; i < images.size(); i++)
+    {
+        cv::Point2f blueCone;
+        cv::Point2f yellowCone;
+        scene.render(i * 11, images[i], blueCone, yellowCone);
+    }
+
+    uint64_t frameNumber = 0;
+    uint64_t allocationsAfterWarmUp = 0;
+    auto acquire = [&](Frame &frame) {
+        if (frameNumber == WARM_UP)
+        {
+            allocationsAfterWarmUp = allocationCount();
+        }
+        if (frameNumber == FRAMES)
+        {
+            return false;
+        }
+        ACQUISITION.copyFrom(reinterpret_cast<const char *>(images[frameNumber % images.size()].data), frame);
+        frame.sampleTimeStamp = static_cast<int64_t>(frameNumber) * 33333;
+        frame.degraded = degraded && frameNumber % 2 == 1;
+        frameNumber++;
+        return true;
+    };
+    auto segment = [&detector](Frame &frame) { detector.segment(frame); };
+    auto detect = [&detector](Frame &frame) { detector.detect(frame); };
+    auto estimate = [&estimator](Frame &frame) { frame.calculatedAngle = estimator.estimate(frame.blueCone, frame.yellowCone); };
+    auto emit = [&output, &encoder](Frame &frame) {
+        output.emit(frame.sampleTimeStamp, frame.calculatedAngle);
+        encoder.encode(static_cast<float>(frame.calculatedAngle), frame.sampleTimeStamp, frame.sampleTimeStamp + 1000, 1);
+    };
+
+    FramePipeline pipeline{acquire, {segment, detect, estimate, emit}, FrameWorkspace{1, ACQUISITION}};
+    pipeline.run(false);
+    return allocationCount() - allocationsAfterWarmUp;
+}
+} // namespace
+
+TEST_CASE("The workspace allocates the buffers of the acquisition up front.")
+{
+    const RegionOfInterest ROI{310, 360, 0, 640};
+    FrameWorkspace band{2, FrameAcquisition{640, 480, ROI, false}};
+    REQUIRE(band.size() == 2);
+    REQUIRE(band[1].image.empty());
+    REQUIRE(band[1].band.rows == 50);
+    REQUIRE(band[1].band.cols == 640);
+
+    FrameWorkspace full{1, FrameAcquisition{640, 480, ROI, true}};
+    REQUIRE(full[0].image.rows == 480);
+    REQUIRE(full[0].band.data == full[0].image.ptr(310));
+
+    FrameWorkspace unsized{0};
+    REQUIRE(unsized.size() == 1);
+    REQUIRE(unsized[0].band.empty());
+}
+
+TEST_CASE("The default band is scaled to the height of the frame.")
+{
+    const RegionOfInterest SAME = defaultRegionOfInterest(640, REFERENCE_FRAME_HEIGHT);
+    REQUIRE(SAME.top == DEFAULT_ROI_TOP);
+    REQUIRE(SAME.bottom == DEFAULT_ROI_BOTTOM);
+    REQUIRE(SAME.right == 640);
+
+    const RegionOfInterest LARGE = defaultRegionOfInterest(1280, 720);
+    REQUIRE(LARGE.top == 465);
+    REQUIRE(LARGE.bottom == 540);
+    REQUIRE(LARGE.left == 0);
+    REQUIRE(LARGE.right == 1280);
+}
+
+TEST_CASE("Only non-empty regions inside the frame are valid.")
+{
+    REQUIRE(RegionOfInterest{310, 360, 0, 640}.validFor(640, 480));
+    REQUIRE(RegionOfInterest{0, 480, 0, 640}.validFor(640, 480));
+    REQUIRE_FALSE(RegionOfInterest{360, 360, 0, 640}.validFor(640, 480));
+    REQUIRE_FALSE(RegionOfInterest{360, 310, 0, 640}.validFor(640, 480));
+    REQUIRE_FALSE(RegionOfInterest{-1, 360, 0, 640}.validFor(640, 480));
+    REQUIRE_FALSE(RegionOfInterest{310, 481, 0, 640}.validFor(640, 480));
+    REQUIRE_FALSE(RegionOfInterest{310, 360, 100, 100}.validFor(640, 480));
+    REQUIRE_FALSE(RegionOfInterest{310, 360, 0, 641}.validFor(640, 480));
+}
+
+TEST_CASE("Processing frames in steady state does not allocate.")
+{
+    REQUIRE(steadyStateAllocations(false, 1, false) == 0);
+    REQUIRE(steadyStateAllocations(true, 1, false) == 0);
+    REQUIRE(steadyStateAllocations(false, 3, false) == 0);
+    REQUIRE(steadyStateAllocations(false, 3, true) == 0);
+}
+
+TEST_CASE("The allocation counter sees allocations.")
+{
+    const uint64_t BEFORE = allocationCount();
+    std::unique_ptr<int> allocated{new int{1}};
+    REQUIRE(allocationCount() > BEFORE);
+}
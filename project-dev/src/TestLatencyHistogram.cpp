@@ -0,0 +1,73 @@
+#include "catch.hpp"
+#include "LatencyHistogram.hpp"
+
+#include <sstream>
+#include <string>
+
+TEST_CASE("An empty latency histogram reports zero.")
+{
+    LatencyHistogram histogram;
+    REQUIRE(histogram.count() == 0);
+    REQUIRE(histogram.max() == 0);
+    REQUIRE(histogram.percentile(50.0) == 0);
+    REQUIRE(histogram.percentile(100.0) == 0);
+}
+
+TEST_CASE("Small latencies are recorded exactly.")
+{
+    LatencyHistogram histogram;
+    for (uint64_t ns = 1; ns <= 20; ns++)
+    {
+        histogram.record(ns);
+    }
+    REQUIRE(histogram.count() == 20);
+    REQUIRE(histogram.percentile(50.0) == 10);
+    REQUIRE(histogram.percentile(90.0) == 18);
+    REQUIRE(histogram.percentile(100.0) == 20);
+    REQUIRE(histogram.max() == 20);
+}
+
+TEST_CASE("Percentiles of large latencies are accurate to the bucket width.")
+{
+    LatencyHistogram histogram;
+    // 1 us to 10 ms in steps of 1 us
+    for (uint64_t us = 1; us <= 10000; us++)
+    {
+        histogram.record(us * 1000);
+    }
+    const double PERCENTILES[] = {50.0, 90.0, 99.0, 99.9};
+    for (double percent : PERCENTILES)
+    {
+        const double EXPECTED = percent * 100.0 * 1000.0;
+        const double ACTUAL = static_cast<double>(histogram.percentile(percent));
+        REQUIRE(ACTUAL >= EXPECTED);
+        REQUIRE(ACTUAL <= EXPECTED * 1.04);
+    }
+    REQUIRE(histogram.percentile(100.0) == 10000000);
+    REQUIRE(histogram.max() == 10000000);
+}
+
+TEST_CASE("Latencies beyond the largest bucket are capped but the maximum is kept.")
+{
+    LatencyHistogram histogram;
+    const uint64_t HUGE_LATENCY = uint64_t{1} << 62;
+    histogram.record(HUGE_LATENCY);
+    REQUIRE(histogram.count() == 1);
+    REQUIRE(histogram.max() == HUGE_LATENCY);
+    REQUIRE(histogram.percentile(50.0) <= HUGE_LATENCY);
+}
+
+TEST_CASE("The latency profile prints only the histograms with values.")
+{
+    LatencyProfile profile;
+    LatencyHistogram &used = profile.add("segmentation");
+    profile.add("wait");
+    used.record(1500);
+
+    std::ostringstream out;
+    profile.print(out);
+    const std::string REPORT = out.str();
+    REQUIRE(REPORT.find("p99.9") != std::string::npos);
+    REQUIRE(REPORT.find("segmentation") != std::string::npos);
+    REQUIRE(REPORT.find("wait") == std::string::npos);
+}
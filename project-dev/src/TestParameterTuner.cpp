@@ -0,0 +1,83 @@
+#include "catch.hpp"
+#include "ParameterTuner.hpp"
+
+#include <vector>
+
+TEST_CASE("Parameter grids contain every valid combination.")
+{
+    REQUIRE(ParameterRange{100, 110, 5}.values() == std::vector<int>({100, 105, 110}));
+    REQUIRE(ParameterRange{7, 7, 1}.values() == std::vector<int>({7}));
+
+    const HsvRangeGrid GRID{{10, 30, 10}, {20, 20, 1}, {0, 0, 1}, {255, 255, 1}, {0, 0, 1}, {255, 255, 1}};
+    // minHue 30 is larger than maxHue 20.
+    REQUIRE(GRID.ranges().size() == 2);
+
+    const SteeringGrid STEERING{{240, 240, 1}, {100, 300, 100}, {360, 360, 1}};
+    REQUIRE(STEERING.thresholds().size() == 2);
+}
+
+TEST_CASE("The tuner finds the HSV range that reproduces the ground truth.")
+{
+    // A blue cone (hue 120) moves from right to left through an HSV band.
+    const int WIDTH = 480;
+    const int HEIGHT = 20;
+    const int CONE = 16;
+    TuningRecording recording;
+    SteeringEstimator reference;
+    for (int x = 460; x >= 0; x -= 20)
+    {
+        cv::Mat hsv(HEIGHT, WIDTH, CV_8UC3, cv::Scalar(0, 0, 0));
+        hsv(cv::Range(2, 2 + CONE), cv::Range(x, x + CONE)).setTo(cv::Scalar(120, 200, 200));
+        recording.hsvBands.push_back(hsv);
+        const float CENTRE = static_cast<float>(x) + (CONE - 1) / 2.0f;
+        recording.groundSteering.push_back(static_cast<float>(reference.estimate(cv::Point2f(CENTRE, 9.5f), cv::Point2f())));
+    }
+
+    ParameterTuner tuner{2, TuningMode{true, 8, false}};
+    tuner.addRecording(std::move(recording));
+    REQUIRE(tuner.frames() == 24);
+
+    // Only the candidates with minHue <= 120 see the cone.
+    const HsvRangeGrid BLUE{{100, 130, 10}, {140, 140, 1}, {120, 120, 1}, {255, 255, 1}, {40, 40, 1}, {255, 255, 1}};
+    const HsvRangeGrid YELLOW{{15, 15, 1}, {25, 25, 1}, {75, 75, 1}, {185, 185, 1}, {147, 147, 1}, {255, 255, 1}};
+    const SteeringGrid STEERING{{240, 240, 1}, {120, 120, 1}, {360, 360, 1}};
+    const TuningResult RESULT = tuner.tune(BLUE, YELLOW, STEERING);
+    REQUIRE(RESULT.candidates == 4);
+    REQUIRE(RESULT.correctAngles == 24);
+    REQUIRE(RESULT.best.blue.minHue == 100);
+
+    const HsvRangeGrid BLIND{{130, 130, 1}, {140, 140, 1}, {120, 120, 1}, {255, 255, 1}, {40, 40, 1}, {255, 255, 1}};
+    REQUIRE(tuner.tune(BLIND, YELLOW, STEERING).correctAngles < 24);
+}
+
+TEST_CASE("With tracking the tuner scores the tracked cones.")
+{
+    // The blue cone of the previous test, steered with its track as template-opencv does by default.
+    const int WIDTH = 480;
+    const int HEIGHT = 20;
+    const int CONE = 16;
+    TuningRecording recording;
+    ConeTracker tracker;
+    SteeringEstimator reference;
+    for (int x = 460; x >= 0; x -= 20)
+    {
+        cv::Mat hsv(HEIGHT, WIDTH, CV_8UC3, cv::Scalar(0, 0, 0));
+        hsv(cv::Range(2, 2 + CONE), cv::Range(x, x + CONE)).setTo(cv::Scalar(120, 200, 200));
+        recording.hsvBands.push_back(hsv);
+        ConeCandidates candidates{};
+        candidates.items[candidates.count++] = ConeCandidate{CONE * CONE, static_cast<float>(x) + (CONE - 1) / 2.0f, 9.5f, x, 2, x + CONE, 2 + CONE};
+        const TrackedCone BLUE = tracker.update(candidates);
+        SteeringFeatures features{};
+        features.blueCone = BLUE.position;
+        features.tracked = true;
+        features.blueVelocity = BLUE.velocity;
+        recording.groundSteering.push_back(static_cast<float>(reference.estimate(features)));
+    }
+
+    ParameterTuner tuner{2, DEFAULT_TUNING_MODE};
+    tuner.addRecording(std::move(recording));
+    const HsvRangeGrid BLUE{{120, 120, 1}, {140, 140, 1}, {120, 120, 1}, {255, 255, 1}, {40, 40, 1}, {255, 255, 1}};
+    const HsvRangeGrid YELLOW{{15, 15, 1}, {25, 25, 1}, {75, 75, 1}, {185, 185, 1}, {147, 147, 1}, {255, 255, 1}};
+    const SteeringGrid STEERING{{240, 240, 1}, {120, 120, 1}, {360, 360, 1}};
+    REQUIRE(tuner.tune(BLUE, YELLOW, STEERING).correctAngles == 24);
+}
@@ -0,0 +1,148 @@
+#include "catch.hpp"
+#include "AllocationCounter.hpp"
+#include "PolynomialSteeringModel.hpp"
+#include "SteeringEstimator.hpp"
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// A drive where the ground truth is a smooth function of the cone positions, which the seven angles of
+// the rules can only approximate.
+std::vector<SteeringRecord> syntheticDrive(uint32_t seed, size_t frames)
+{
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> x(20.0f, 620.0f);
+    std::uniform_int_distribution<int32_t> area(80, 800);
+    std::vector<SteeringRecord> records;
+    for (size_t i = 0; i < frames; i++)
+    {
+        SteeringRecord record{};
+        record.sampleTimeStamp = static_cast<int64_t>(i) * 100000;
+        record.blueConeX = (i % 7 == 0) ? 0.0f : x(random);
+        record.yellowConeX = (i % 5 == 0) ? 0.0f : x(random);
+        record.blueConeArea = record.blueConeX > 0.0f ? area(random) : 0;
+        record.yellowConeArea = record.yellowConeX > 0.0f ? area(random) : 0;
+        record.blueBlobs = record.blueConeX > 0.0f ? 1 : 0;
+        record.yellowBlobs = record.yellowConeX > 0.0f ? 1 : 0;
+        record.groundSteering = 0.1f + 0.0004f * (record.blueConeX - 320.0f) - 0.0003f * (record.yellowConeX - 320.0f);
+        records.push_back(record);
+    }
+    return records;
+}
+} // namespace
+
+TEST_CASE("The polynomial model is fitted to the ground truth of steering logs.")
+{
+    const std::vector<std::vector<SteeringRecord>> LOGS{syntheticDrive(1, 400), syntheticDrive(2, 300)};
+    PolynomialSteeringParameters parameters{};
+    std::string error;
+    REQUIRE(fitPolynomialSteeringModel(LOGS, 1e-6, parameters, error));
+
+    // Frames the model was not fitted to.
+    PolynomialSteeringModel model{parameters};
+    for (const SteeringRecord &record : syntheticDrive(3, 200))
+    {
+        REQUIRE(model.estimate(makeSteeringFeatures(record)) == Approx(record.groundSteering).margin(0.005));
+    }
+}
+
+TEST_CASE("The polynomial model clamps its angles to the fitted range.")
+{
+    PolynomialSteeringParameters parameters{};
+    parameters.weights[1] = 1.0f; // the angle is the x of the blue cone
+    parameters.scale[0] = 1.0f;
+    parameters.minAngle = -0.3f;
+    parameters.maxAngle = 0.3f;
+    PolynomialSteeringModel model{parameters};
+    const SteeringFeatures FEATURES{cv::Point2f(0.2f, 0.0f), cv::Point2f(), 0, 0, 0, 0, false, cv::Point2f(), cv::Point2f()};
+    REQUIRE(model.estimate(FEATURES) == Approx(0.2));
+    const SteeringFeatures FAR_RIGHT{cv::Point2f(500.0f, 0.0f), cv::Point2f(), 0, 0, 0, 0, false, cv::Point2f(), cv::Point2f()};
+    REQUIRE(model.estimate(FAR_RIGHT) == Approx(0.3));
+}
+
+TEST_CASE("The movement of the cones is only an input when they are in consecutive frames.")
+{
+    SteeringInputs inputs;
+    const SteeringInputs::Values FIRST = inputs.next(SteeringFeatures{cv::Point2f(100.0f, 0.0f), cv::Point2f(), 90, 0, 1, 0, false, cv::Point2f(), cv::Point2f()});
+    REQUIRE(FIRST[6] == Approx(0.0));
+    const SteeringInputs::Values SECOND = inputs.next(SteeringFeatures{cv::Point2f(90.0f, 0.0f), cv::Point2f(300.0f, 0.0f), 90, 90, 1, 1, false, cv::Point2f(), cv::Point2f()});
+    REQUIRE(SECOND[6] == Approx(-10.0));
+    REQUIRE(SECOND[7] == Approx(0.0));
+    const SteeringInputs::Values THIRD = inputs.next(SteeringFeatures{cv::Point2f(), cv::Point2f(310.0f, 0.0f), 0, 90, 0, 1, false, cv::Point2f(), cv::Point2f()});
+    REQUIRE(THIRD[6] == Approx(0.0));
+    REQUIRE(THIRD[7] == Approx(10.0));
+}
+
+TEST_CASE("Steering models are written and read back.")
+{
+    PolynomialSteeringParameters parameters{};
+    std::string error;
+    REQUIRE(fitPolynomialSteeringModel({syntheticDrive(4, 100)}, 0.001, parameters, error));
+    std::stringstream file;
+    writeSteeringModel(file, parameters);
+    PolynomialSteeringParameters read{};
+    REQUIRE(readSteeringModel(file, read, error));
+    for (size_t i = 0; i < PolynomialSteeringModel::TERMS; i++)
+    {
+        REQUIRE(read.weights[i] == Approx(parameters.weights[i]));
+    }
+    for (size_t i = 0; i < SteeringInputs::COUNT; i++)
+    {
+        REQUIRE(read.mean[i] == Approx(parameters.mean[i]));
+        REQUIRE(read.scale[i] == Approx(parameters.scale[i]));
+    }
+    REQUIRE(read.minAngle == Approx(parameters.minAngle));
+    REQUIRE(read.maxAngle == Approx(parameters.maxAngle));
+}
+
+TEST_CASE("Invalid steering models are rejected.")
+{
+    std::stringstream valid;
+    writeSteeringModel(valid, PolynomialSteeringParameters{});
+    const std::string VALID = valid.str();
+    const std::string INVALID[] = {"", "polynomial-steering-model 2\n", VALID.substr(0, VALID.find("weights")),
+                                   "polynomial-steering-model 1\nmean 1 2 3\n",
+                                   VALID.substr(0, VALID.find("angles")) + "angles 0.3 -0.3\n"};
+    for (const std::string &text : INVALID)
+    {
+        std::istringstream in(text);
+        PolynomialSteeringParameters parameters{};
+        std::string error;
+        REQUIRE_FALSE(readSteeringModel(in, parameters, error));
+        REQUIRE_FALSE(error.empty());
+    }
+
+    PolynomialSteeringParameters parameters{};
+    std::string error;
+    REQUIRE_FALSE(fitPolynomialSteeringModel({}, 0.001, parameters, error));
+}
+
+TEST_CASE("Steering models are interchangeable and do not allocate.")
+{
+    PolynomialSteeringParameters parameters{};
+    std::string error;
+    REQUIRE(fitPolynomialSteeringModel({syntheticDrive(5, 100)}, 0.001, parameters, error));
+    SteeringEstimator rules;
+    PolynomialSteeringModel polynomial{parameters};
+    SteeringModel *const MODELS[] = {&rules, &polynomial};
+    const SteeringFeatures FEATURES{cv::Point2f(150.0f, 320.0f), cv::Point2f(400.0f, 320.0f), 200, 300, 1, 2, false, cv::Point2f(), cv::Point2f()};
+
+    const uint64_t BEFORE = allocationCount();
+    for (SteeringModel *model : MODELS)
+    {
+        model->estimate(FEATURES);
+    }
+    REQUIRE(allocationCount() == BEFORE);
+
+    // Through the interface the rules steer as with the cone positions.
+    SteeringEstimator sameRules;
+    sameRules.estimate(FEATURES.blueCone, FEATURES.yellowCone);
+    const SteeringFeatures NEXT{cv::Point2f(140.0f, 320.0f), cv::Point2f(), 200, 0, 1, 0, false, cv::Point2f(), cv::Point2f()};
+    const double ANGLE = rules.estimate(NEXT);
+    REQUIRE(ANGLE == Approx(sameRules.estimate(NEXT.blueCone, NEXT.yellowCone)));
+    REQUIRE(ANGLE == Approx(-0.1));
+}
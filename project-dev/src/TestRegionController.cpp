@@ -0,0 +1,116 @@
+#include "catch.hpp"
+#include "AllocationCounter.hpp"
+#include "ConeDetector.hpp"
+#include "ConeTracker.hpp"
+#include "RegionController.hpp"
+#include "SyntheticScene.hpp"
+
+namespace
+{
+void addCandidate(ConeCandidates &candidates, const cv::Point2f &cone)
+{
+    if (cone.x > 0.0f)
+    {
+        const int X = static_cast<int>(cone.x);
+        const int Y = static_cast<int>(cone.y);
+        candidates.items[candidates.count++] = ConeCandidate{100, cone.x, cone.y, X - 5, Y - 5, X + 6, Y + 6};
+    }
+}
+
+// A frame with the cones as detected.
+Frame frameWithCones(const cv::Point2f &blueCone, const cv::Point2f &yellowCone)
+{
+    Frame frame;
+    frame.blueCone = blueCone;
+    frame.yellowCone = yellowCone;
+    addCandidate(frame.blueCandidates, blueCone);
+    addCandidate(frame.yellowCandidates, yellowCone);
+    return frame;
+}
+} // namespace
+
+TEST_CASE("The window follows the cones and widens when one is lost.")
+{
+    RegionController controller{640, 50};
+    REQUIRE(controller.next().width == 0);
+
+    Frame frame = frameWithCones(cv::Point2f(200.0f, 30.0f), cv::Point2f(300.0f, 25.0f));
+    frame.blueVelocity = cv::Point2f(-4.0f, 0.0f);
+    frame.blueCandidates.items[0] = ConeCandidate{300, 200.0f, 30.0f, 190, 15, 210, 45};
+    controller.update(frame);
+    const cv::Rect WINDOW = controller.next();
+    // From the box of the blue cone to that of the yellow one, which ends at 306, grown by the margin.
+    REQUIRE(WINDOW.x == 190 - RegionController::MARGIN);
+    REQUIRE(WINDOW.x + WINDOW.width == 306 + RegionController::MARGIN);
+    REQUIRE(WINDOW.y == 0);
+    REQUIRE(WINDOW.height == 50);
+
+    controller.update(frameWithCones(cv::Point2f(200.0f, 30.0f), cv::Point2f()));
+    REQUIRE(controller.next().width == 0);
+
+    // A coasting track is not enough: the cone may have left the window.
+    frame.yellowCandidates = ConeCandidates{};
+    controller.update(frame);
+    REQUIRE(controller.next().width == 0);
+}
+
+TEST_CASE("The whole band is searched every REFRESH_FRAMES frames.")
+{
+    RegionController controller{640, 50};
+    size_t whole = 0;
+    for (int i = 0; i < 3 * RegionController::REFRESH_FRAMES; i++)
+    {
+        controller.update(frameWithCones(cv::Point2f(300.0f, 25.0f), cv::Point2f(320.0f, 25.0f)));
+        const cv::Rect WINDOW = controller.next();
+        whole += (WINDOW.width == 0) ? 1 : 0;
+        REQUIRE((WINDOW.width == 0 || WINDOW.width < 640));
+    }
+    REQUIRE(whole == 3);
+}
+
+TEST_CASE("The cones are found in the window at the same positions as in the whole band.")
+{
+    const RegionOfInterest ROI{310, 360, 0, 640};
+    SyntheticScene scene{640, 480, ROI};
+    ConeDetector wholeBand{ROI.width(), ROI.height(), false, 6, false};
+    ConeDetector windowed{ROI.width(), ROI.height(), false, 6, false};
+    FrameConeTracker tracker;
+    RegionController controller{ROI.width(), ROI.height()};
+    cv::Mat image;
+    Frame reference;
+    Frame frame;
+    int searchedColumns = 0;
+    // Until the yellow cone leaves the band and starts over on the other side.
+    const uint64_t FRAMES = 75;
+    for (uint64_t number = 0; number < FRAMES; number++)
+    {
+        cv::Point2f blueCone;
+        cv::Point2f yellowCone;
+        scene.render(number, image, blueCone, yellowCone);
+        reference.band = image(cv::Range(ROI.top, ROI.bottom), cv::Range(ROI.left, ROI.right));
+        wholeBand.segment(reference);
+        wholeBand.detect(reference);
+
+        frame.band = reference.band;
+        frame.window = controller.next();
+        const uint64_t BEFORE = allocationCount();
+        windowed.segment(frame);
+        windowed.detect(frame);
+        // The first frame searches the whole band, which sizes the buffers for every window.
+        REQUIRE((number == 0 || allocationCount() == BEFORE));
+        searchedColumns += (frame.window.width > 0) ? frame.window.width : ROI.width();
+
+        REQUIRE(frame.blueCandidates.count == reference.blueCandidates.count);
+        REQUIRE(frame.yellowCandidates.count == reference.yellowCandidates.count);
+        REQUIRE(frame.blueCone.x == Approx(reference.blueCone.x));
+        REQUIRE(frame.blueCone.y == Approx(reference.blueCone.y));
+        REQUIRE(frame.yellowCone.x == Approx(reference.yellowCone.x));
+        REQUIRE(frame.blueCandidates.largest().left == reference.blueCandidates.largest().left);
+        REQUIRE(frame.yellowCandidates.largest().bottom == reference.yellowCandidates.largest().bottom);
+
+        tracker.track(frame);
+        controller.update(frame);
+    }
+    // The cones are at most half the band apart, so the window spans less than two thirds of it.
+    REQUIRE(searchedColumns < static_cast<int>(FRAMES) * ROI.width() * 3 / 4);
+}
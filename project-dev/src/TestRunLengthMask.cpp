@@ -0,0 +1,97 @@
+#include "catch.hpp"
+#include "BlobExtractor.hpp"
+#include "ConeColorTable.hpp"
+#include "ConeSegmentation.hpp"
+#include "RunLengthMask.hpp"
+
+#include <cstring>
+#include <random>
+
+namespace
+{
+bool sameMask(const cv::Mat &a, const cv::Mat &b)
+{
+    return a.rows == b.rows && a.cols == b.cols && 0 == std::memcmp(a.data, b.data, a.total());
+}
+
+cv::Mat sparseMask(int rows, int cols, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    cv::Mat mask = cv::Mat::zeros(rows, cols, CV_8UC1);
+    for (int i = 0; i < rows * cols / 20; i++)
+    {
+        const int row = static_cast<int>(rng() % static_cast<uint32_t>(rows));
+        const int col = static_cast<int>(rng() % static_cast<uint32_t>(cols - 5));
+        std::memset(mask.ptr<uint8_t>(row) + col, 255, 1 + rng() % 5);
+    }
+    return mask;
+}
+} // namespace
+
+TEST_CASE("A run-length encoded mask expands to the mask it was built from.")
+{
+    const cv::Mat mask = sparseMask(50, 641, 1);
+    RunLengthMask encoded;
+    encoded.assign(mask);
+    REQUIRE(encoded.rows() == 50);
+    REQUIRE(encoded.cols() == 641);
+    REQUIRE(encoded.pixelCount() == static_cast<size_t>(cv::countNonZero(mask)));
+
+    cv::Mat decoded;
+    encoded.toMat(decoded);
+    REQUIRE(sameMask(mask, decoded));
+
+    // Runs touching both borders.
+    cv::Mat full = cv::Mat::zeros(2, 16, CV_8UC1);
+    std::memset(full.ptr<uint8_t>(1), 255, 16);
+    encoded.assign(full);
+    REQUIRE(encoded.runCount() == 1);
+    REQUIRE(encoded.rowBegin(1)->begin == 0);
+    REQUIRE(encoded.rowBegin(1)->end == 16);
+}
+
+TEST_CASE("Segmentation emits the same runs as encoding the pixel masks.")
+{
+    std::mt19937 rng(5);
+    cv::Mat band(50, 640, CV_8UC4);
+    for (size_t i = 0; i < band.total() * 4; i++)
+    {
+        band.data[i] = static_cast<uint8_t>(rng());
+    }
+
+    cv::Mat blueExpected, yellowExpected, blueDecoded, yellowDecoded;
+    RunLengthMask blueMask, yellowMask;
+    segmentCones(band, BLUE_CONE_RANGE, YELLOW_CONE_RANGE, blueExpected, yellowExpected);
+    segmentCones(band, BLUE_CONE_RANGE, YELLOW_CONE_RANGE, blueMask, yellowMask);
+    blueMask.toMat(blueDecoded);
+    yellowMask.toMat(yellowDecoded);
+    REQUIRE(sameMask(blueExpected, blueDecoded));
+    REQUIRE(sameMask(yellowExpected, yellowDecoded));
+
+    const ConeColorTable table(BLUE_CONE_RANGE, YELLOW_CONE_RANGE, 6);
+    table.segment(band, blueExpected, yellowExpected);
+    table.segment(band, blueMask, yellowMask);
+    blueMask.toMat(blueDecoded);
+    yellowMask.toMat(yellowDecoded);
+    REQUIRE(sameMask(blueExpected, blueDecoded));
+    REQUIRE(sameMask(yellowExpected, yellowDecoded));
+}
+
+TEST_CASE("Blob extraction gives the same result for runs and pixels.")
+{
+    const cv::Mat mask = sparseMask(50, 640, 9);
+    RunLengthMask encoded;
+    encoded.assign(mask);
+
+    BlobExtractor extractor(640, 50);
+    const ConeCandidates fromPixels = extractor.extract(mask, 3);
+    const ConeCandidates fromRuns = extractor.extract(encoded, 3);
+    REQUIRE(fromPixels.count > 0);
+    REQUIRE(fromPixels.count == fromRuns.count);
+    for (size_t i = 0; i < fromRuns.count; i++)
+    {
+        REQUIRE(fromPixels.items[i].area == fromRuns.items[i].area);
+        REQUIRE(fromPixels.items[i].x == Approx(fromRuns.items[i].x));
+        REQUIRE(fromPixels.items[i].y == Approx(fromRuns.items[i].y));
+    }
+}
@@ -0,0 +1,73 @@
+#include "catch.hpp"
+#include "SteeringLog.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("The steering log writes every record in order and converts it to the CSV layout.")
+{
+    const std::string FILE_NAME{"TestSteeringLog.log"};
+    const int RECORDS = 1000;
+    {
+        // A small ring so that the writer has to keep up while the records are logged.
+        SteeringLog log(FILE_NAME, 64);
+        REQUIRE(log.isOpen());
+        for (int i = 0; i < RECORDS; i++)
+        {
+            SteeringRecord record{};
+            record.sampleTimeStamp = 1000000 + i;
+            record.groundSteering = 0.25f;
+            record.calculatedAngle = -0.1;
+            record.blueBlobs = static_cast<uint16_t>(i % 3);
+            log.log(record);
+            if (i % 32 == 31)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+        REQUIRE(log.dropped() == 0);
+    }
+
+    std::vector<SteeringRecord> records;
+    REQUIRE(readSteeringLog(FILE_NAME, records));
+    std::remove(FILE_NAME.c_str());
+    REQUIRE(records.size() == static_cast<size_t>(RECORDS));
+    for (int i = 0; i < RECORDS; i++)
+    {
+        REQUIRE(records[static_cast<size_t>(i)].sampleTimeStamp == 1000000 + i);
+        REQUIRE(records[static_cast<size_t>(i)].blueBlobs == i % 3);
+    }
+
+    records.resize(2);
+    std::ostringstream csv;
+    writeSteeringCsv(csv, records, false);
+    REQUIRE(csv.str() ==
+            "Timestamp ,GroundSteeringRequest ,Calculated Angle\n"
+            "1000000,0.250000,-0.100000\n"
+            "1000001,0.250000,-0.100000\n");
+}
+
+TEST_CASE("Files that are not steering logs are rejected.")
+{
+    std::vector<SteeringRecord> records;
+    REQUIRE_FALSE(readSteeringLog("does-not-exist.log", records));
+}
+
+TEST_CASE("The record has the x of the cone steered by but the area of the largest candidate.")
+{
+    Frame frame;
+    frame.blueCandidates.items[0] = ConeCandidate{400, 300.0f, 20.0f, 290, 10, 311, 31};
+    frame.blueCandidates.items[1] = ConeCandidate{100, 120.0f, 30.0f, 115, 25, 126, 36};
+    frame.blueCandidates.count = 2;
+    frame.blueCone = cv::Point2f(120.0f, 30.0f);
+
+    const SteeringRecord RECORD = makeSteeringRecord(frame);
+    REQUIRE(RECORD.blueConeX == Approx(120.0f));
+    REQUIRE(RECORD.blueConeArea == 400);
+    REQUIRE(RECORD.blueBlobs == 2);
+    REQUIRE(RECORD.yellowConeArea == 0);
+}
@@ -0,0 +1,45 @@
+#include "catch.hpp"
+#include "SteeringOutput.hpp"
+
+#include <sstream>
+#include <string>
+
+TEST_CASE("The buffered steering output matches streaming std::to_string.")
+{
+    const int64_t TIMESTAMPS[] = {0, 1234567890123456, -5};
+    const double ANGLES[] = {0.0, -0.123456789, 0.29, 1e10, -1e300};
+
+    std::ostringstream expected;
+    std::ostringstream actual;
+    {
+        SteeringOutput output(actual, FlushPolicy{0, std::chrono::milliseconds(0)});
+        for (int64_t ts : TIMESTAMPS)
+        {
+            for (double angle : ANGLES)
+            {
+                expected << "Group 15; " << std::to_string(ts) << "; " << std::to_string(angle) << std::endl;
+                output.emit(ts, angle);
+            }
+        }
+    }
+    REQUIRE(actual.str() == expected.str());
+}
+
+TEST_CASE("The steering output is flushed according to the policy.")
+{
+    std::ostringstream out;
+    SteeringOutput output(out, FlushPolicy{3, std::chrono::milliseconds(0)});
+    output.emit(1, 0.0);
+    output.emit(2, 0.0);
+    REQUIRE(out.str().empty());
+    output.emit(3, 0.0);
+    REQUIRE(out.str() == "Group 15; 1; 0.000000\nGroup 15; 2; 0.000000\nGroup 15; 3; 0.000000\n");
+
+    std::ostringstream small;
+    SteeringOutput full(small, FlushPolicy{0, std::chrono::milliseconds(0)}, 40);
+    full.emit(1, 0.0);
+    full.emit(2, 0.0);
+    REQUIRE(small.str() == "Group 15; 1; 0.000000\n");
+    full.flush();
+    REQUIRE(small.str() == "Group 15; 1; 0.000000\nGroup 15; 2; 0.000000\n");
+}
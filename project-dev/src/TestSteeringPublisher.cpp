@@ -0,0 +1,68 @@
+#include "catch.hpp"
+#include "SteeringPublisher.hpp"
+
+#include "cluon-complete.hpp"
+#include "opendlv-standard-message-set.hpp"
+
+#include <sstream>
+#include <string>
+#include <utility>
+
+namespace
+{
+// What OD4Session::send() puts on the wire for the same request.
+std::string cluonPacket(float groundSteering, int64_t sampleTimeStamp, int64_t sentTimeStamp, uint32_t senderStamp)
+{
+    opendlv::proxy::GroundSteeringRequest request;
+    request.groundSteering(groundSteering);
+    cluon::ToProtoVisitor protoEncoder;
+    request.accept(protoEncoder);
+
+    cluon::data::Envelope envelope;
+    envelope.dataType(opendlv::proxy::GroundSteeringRequest::ID());
+    envelope.serializedData(protoEncoder.encodedData());
+    envelope.sent(cluon::time::fromMicroseconds(sentTimeStamp));
+    envelope.sampleTimeStamp(cluon::time::fromMicroseconds(sampleTimeStamp));
+    envelope.senderStamp(senderStamp);
+    return cluon::serializeEnvelope(std::move(envelope));
+}
+} // namespace
+
+TEST_CASE("The encoded GroundSteeringRequest matches the packet of the OD4Session.")
+{
+    GroundSteeringEncoder encoder;
+    const float ANGLES[] = {0.0f, -0.25f, 0.123456f};
+    const uint32_t SENDER_STAMPS[] = {0, 1, 300, 4000000000u};
+    for (float angle : ANGLES)
+    {
+        for (uint32_t senderStamp : SENDER_STAMPS)
+        {
+            const int64_t SAMPLE = 1615306040123456;
+            const int64_t SENT = 1615306040130001;
+            REQUIRE(encoder.encode(angle, SAMPLE, SENT, senderStamp) == cluonPacket(angle, SAMPLE, SENT, senderStamp));
+        }
+    }
+}
+
+TEST_CASE("The encoded GroundSteeringRequest is extracted by cluon.")
+{
+    GroundSteeringEncoder encoder;
+    const std::string PACKET = encoder.encode(-0.2f, 1000000, 2000000, 7);
+    std::stringstream in(PACKET);
+    std::pair<bool, cluon::data::Envelope> extracted = cluon::extractEnvelope(in);
+    REQUIRE(extracted.first);
+    cluon::data::Envelope envelope = extracted.second;
+    REQUIRE(envelope.senderStamp() == 7);
+    REQUIRE(cluon::time::toMicroseconds(envelope.sampleTimeStamp()) == 1000000);
+    REQUIRE(cluon::extractMessage<opendlv::proxy::GroundSteeringRequest>(std::move(envelope)).groundSteering() == Approx(-0.2f));
+}
+
+TEST_CASE("Encoding reuses the packet buffer.")
+{
+    GroundSteeringEncoder encoder;
+    const char *buffer = encoder.encode(0.1f, 1, 2, 3).data();
+    for (int64_t ts = 0; ts < 1000; ts++)
+    {
+        REQUIRE(encoder.encode(0.1f, ts * 33333, ts * 33333 + 100, 3).data() == buffer);
+    }
+}
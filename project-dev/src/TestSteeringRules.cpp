@@ -0,0 +1,176 @@
+#include "catch.hpp"
+#include "SteeringEstimator.hpp"
+#include "SteeringRules.hpp"
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// The if/else chains the rule tables replaced (with the edges 5 and 480 as thresholds), as the reference.
+double clockwiseChain(cv::Point2f b, cv::Point2f y, const SteeringThresholds &t)
+{
+    if (b.x < t.leftThreshold || y.x > t.rightThreshold) { return 0.0; }
+    if (b.x < t.carPosition && b.x > t.leftThreshold) { return -0.1; }
+    if (b.x > t.carPosition && b.x < t.rightThreshold) { return -0.2; }
+    if (b.x < t.rightEdge && b.x > t.rightThreshold) { return -0.25; }
+    if (y.x < t.rightThreshold && y.x > t.carPosition) { return 0.1; }
+    if (y.x < t.carPosition && y.x > t.leftThreshold) { return 0.2; }
+    if (y.x > t.leftEdge && y.x < t.leftThreshold) { return 0.25; }
+    return 0.0;
+}
+
+double counterClockwiseChain(cv::Point2f b, cv::Point2f y, const SteeringThresholds &t)
+{
+    if (y.x < t.leftThreshold || b.x > t.rightThreshold) { return 0.0; }
+    if (y.x < t.carPosition && y.x > t.leftThreshold) { return -0.1; }
+    if (y.x > t.carPosition && y.x < t.rightThreshold) { return -0.2; }
+    if (y.x > t.rightThreshold && y.x < t.rightEdge) { return -0.25; }
+    if (b.x < t.leftThreshold && b.x > t.carPosition) { return 0.1; }
+    if (b.x < t.carPosition && b.x > t.leftThreshold) { return 0.2; }
+    if (b.x < t.leftThreshold && b.x > t.leftEdge) { return 0.25; }
+    return 0.0;
+}
+
+// Positions on, next to and between all bounds, plus "no cone".
+std::vector<float> interestingPositions(const SteeringThresholds &t)
+{
+    std::vector<float> positions{0.0f, 1000.0f};
+    for (int bound : {t.leftEdge, t.leftThreshold, t.carPosition, t.rightThreshold, t.rightEdge})
+    {
+        for (float offset : {-1.0f, -0.5f, 0.0f, 0.5f, 1.0f})
+        {
+            positions.push_back(static_cast<float>(bound) + offset);
+        }
+    }
+    return positions;
+}
+} // namespace
+
+TEST_CASE("The rule tables steer like the if/else chains.")
+{
+    const SteeringThresholds THRESHOLDS[] = {DEFAULT_STEERING_THRESHOLDS, SteeringThresholds{300, 200, 400, 5, 480},
+                                             SteeringThresholds{240, 120, 360, 120, 480}};
+    const SteeringRules RULES = defaultSteeringRules();
+    for (const SteeringThresholds &thresholds : THRESHOLDS)
+    {
+        const SteeringRuleTable CLOCKWISE{RULES.clockwise, thresholds};
+        const SteeringRuleTable COUNTER_CLOCKWISE{RULES.counterClockwise, thresholds};
+        const std::vector<float> POSITIONS = interestingPositions(thresholds);
+        for (float blue : POSITIONS)
+        {
+            for (float yellow : POSITIONS)
+            {
+                const cv::Point2f BLUE{blue, 10.0f};
+                const cv::Point2f YELLOW{yellow, 10.0f};
+                REQUIRE(CLOCKWISE.angle(BLUE, YELLOW) == Approx(clockwiseChain(BLUE, YELLOW, thresholds)));
+                REQUIRE(COUNTER_CLOCKWISE.angle(BLUE, YELLOW) == Approx(counterClockwiseChain(BLUE, YELLOW, thresholds)));
+            }
+        }
+
+        std::mt19937 random(7);
+        std::uniform_real_distribution<float> x(-10.0f, 650.0f);
+        for (int i = 0; i < 10000; i++)
+        {
+            const cv::Point2f BLUE{x(random), 0.0f};
+            const cv::Point2f YELLOW{x(random), 0.0f};
+            REQUIRE(CLOCKWISE.angle(BLUE, YELLOW) == Approx(clockwiseChain(BLUE, YELLOW, thresholds)));
+            REQUIRE(COUNTER_CLOCKWISE.angle(BLUE, YELLOW) == Approx(counterClockwiseChain(BLUE, YELLOW, thresholds)));
+        }
+    }
+}
+
+TEST_CASE("The counter-clockwise rule for a blue cone between the car and the right threshold never applies.")
+{
+    const SteeringRuleTable COUNTER_CLOCKWISE{defaultSteeringRules().counterClockwise, DEFAULT_STEERING_THRESHOLDS};
+    // The yellow cone is past the right edge, so only the rules for the blue cone can apply.
+    const cv::Point2f YELLOW{1000.0f, 10.0f};
+    for (int x = 0; x <= RIGHT_THRESHOLD; x++)
+    {
+        REQUIRE(COUNTER_CLOCKWISE.angle(cv::Point2f(static_cast<float>(x), 10.0f), YELLOW) != Approx(0.1));
+    }
+    REQUIRE(COUNTER_CLOCKWISE.angle(cv::Point2f(300.0f, 10.0f), YELLOW) == Approx(0.0));
+    REQUIRE(COUNTER_CLOCKWISE.angle(cv::Point2f(200.0f, 10.0f), YELLOW) == Approx(0.2));
+}
+
+TEST_CASE("Steering rules are read from text and replace the rules of their direction.")
+{
+    std::istringstream in("# sharper turns\n"
+                          "\n"
+                          "clockwise blue -inf left 0\n"
+                          "clockwise blue left inf -0.5\n");
+    SteeringRules rules = defaultSteeringRules();
+    std::string error;
+    REQUIRE(readSteeringRules(in, rules, error));
+    REQUIRE(rules.clockwise.count == 2);
+    REQUIRE(rules.clockwise.rules[1].lower == RuleBound::LEFT);
+    REQUIRE(rules.clockwise.rules[1].upper == RuleBound::NONE_ABOVE);
+    REQUIRE(rules.clockwise.rules[1].angle == Approx(-0.5));
+    REQUIRE(rules.counterClockwise.count == defaultSteeringRules().counterClockwise.count);
+
+    const SteeringRuleTable TABLE{rules.clockwise, DEFAULT_STEERING_THRESHOLDS};
+    REQUIRE(TABLE.angle(cv::Point2f(100.0f, 0.0f), cv::Point2f()) == Approx(0.0));
+    REQUIRE(TABLE.angle(cv::Point2f(500.0f, 0.0f), cv::Point2f()) == Approx(-0.5));
+}
+
+TEST_CASE("Invalid steering rules are rejected with the line.")
+{
+    const char *INVALID[] = {"clockwise green left car 0.1\n", "sideways blue left car 0.1\n",
+                             "clockwise blue left middle 0.1\n", "clockwise blue left car\n", "clockwise blue left car 0.1 0.2\n"};
+    for (const char *text : INVALID)
+    {
+        std::istringstream in(std::string("\nclockwise blue left car 0.1\n") + text);
+        SteeringRules rules = defaultSteeringRules();
+        std::string error;
+        REQUIRE_FALSE(readSteeringRules(in, rules, error));
+        REQUIRE(error.find("line 3") != std::string::npos);
+        REQUIRE(rules.clockwise.count == defaultSteeringRules().clockwise.count);
+    }
+
+    std::ostringstream tooMany;
+    for (size_t i = 0; i <= SteeringRuleSet::CAPACITY; i++)
+    {
+        tooMany << "counter-clockwise yellow car right 0.1\n";
+    }
+    std::istringstream in(tooMany.str());
+    SteeringRules rules = defaultSteeringRules();
+    std::string error;
+    REQUIRE_FALSE(readSteeringRules(in, rules, error));
+}
+
+TEST_CASE("The thresholds are scaled to the width of the frame.")
+{
+    const SteeringThresholds SAME = scaledSteeringThresholds(DEFAULT_STEERING_THRESHOLDS, REFERENCE_FRAME_WIDTH);
+    REQUIRE(SAME.carPosition == CAR_POSITION);
+    REQUIRE(SAME.rightEdge == RIGHT_EDGE_POSITION);
+
+    const SteeringThresholds WIDE = scaledSteeringThresholds(DEFAULT_STEERING_THRESHOLDS, 1280);
+    REQUIRE(WIDE.carPosition == 2 * CAR_POSITION);
+    REQUIRE(WIDE.leftThreshold == 2 * LEFT_THRESHOLD);
+    REQUIRE(WIDE.rightThreshold == 2 * RIGHT_THRESHOLD);
+    REQUIRE(WIDE.leftEdge == 2 * LEFT_EDGE_POSITION);
+    REQUIRE(WIDE.rightEdge == 2 * RIGHT_EDGE_POSITION);
+
+    // A cone at the same fraction of a narrower frame gets the same angle.
+    const SteeringThresholds NARROW = scaledSteeringThresholds(DEFAULT_STEERING_THRESHOLDS, 320);
+    REQUIRE(NARROW.leftEdge == 3);
+    const SteeringRuleTable REFERENCE{defaultSteeringRules().clockwise, DEFAULT_STEERING_THRESHOLDS};
+    const SteeringRuleTable SCALED{defaultSteeringRules().clockwise, NARROW};
+    for (float x = 10.0f; x < 640.0f; x += 20.0f)
+    {
+        REQUIRE(SCALED.angle(cv::Point2f(x / 2.0f, 0.0f), cv::Point2f()) == Approx(REFERENCE.angle(cv::Point2f(x, 0.0f), cv::Point2f())));
+    }
+}
+
+TEST_CASE("The estimator uses the rules of the direction the cones move in.")
+{
+    SteeringEstimator estimator;
+    // No previous cones: the direction is unknown.
+    REQUIRE(estimator.estimate(cv::Point2f(200.0f, 0.0f), cv::Point2f()) == Approx(0.0));
+    // Blue moved to the left: clockwise rules, blue between left threshold and car.
+    REQUIRE(estimator.estimate(cv::Point2f(150.0f, 0.0f), cv::Point2f()) == Approx(-0.1));
+    // Blue moved to the right: counter-clockwise rules, yellow between car and right threshold.
+    REQUIRE(estimator.estimate(cv::Point2f(160.0f, 0.0f), cv::Point2f(300.0f, 0.0f)) == Approx(-0.2));
+}
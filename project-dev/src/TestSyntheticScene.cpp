@@ -0,0 +1,56 @@
+#include "catch.hpp"
+#include "ConeDetector.hpp"
+#include "SyntheticScene.hpp"
+
+TEST_CASE("The cones of the synthetic scene are detected at their known positions.")
+{
+    const RegionOfInterest ROI{310, 360, 0, 640};
+    SyntheticScene scene{640, 480, ROI};
+    ConeDetector detector{ROI.width(), ROI.height(), false, 6, false};
+    cv::Mat image;
+    Frame frame;
+    for (uint64_t number = 0; number < 400; number += 37)
+    {
+        cv::Point2f blueCone;
+        cv::Point2f yellowCone;
+        scene.render(number, image, blueCone, yellowCone);
+        frame.band = image(cv::Range(ROI.top, ROI.bottom), cv::Range(ROI.left, ROI.right));
+        detector.segment(frame);
+        detector.detect(frame);
+
+        // The band starts at row 310.
+        REQUIRE(frame.blueCone.x == Approx(blueCone.x));
+        REQUIRE(frame.blueCone.y + ROI.top == Approx(blueCone.y));
+        REQUIRE(frame.yellowCone.x == Approx(yellowCone.x));
+        REQUIRE(frame.blueCandidates.count == 1);
+        REQUIRE(frame.yellowCandidates.count == 1);
+    }
+}
+
+TEST_CASE("Degraded frames find the same cones from every other row.")
+{
+    const RegionOfInterest ROI{310, 360, 0, 640};
+    SyntheticScene scene{640, 480, ROI};
+    ConeDetector detector{ROI.width(), ROI.height(), false, 6, true};
+    cv::Mat image;
+    Frame frame;
+    frame.degraded = true;
+    for (uint64_t number = 0; number < 400; number += 37)
+    {
+        cv::Point2f blueCone;
+        cv::Point2f yellowCone;
+        scene.render(number, image, blueCone, yellowCone);
+        frame.band = image(cv::Range(ROI.top, ROI.bottom), cv::Range(ROI.left, ROI.right));
+        detector.segment(frame);
+        detector.detect(frame);
+
+        REQUIRE(frame.blueMask.rows() == ROI.height() / 2);
+        REQUIRE(frame.blueCone.x == Approx(blueCone.x));
+        // In rows of the band, like the cones of full frames.
+        REQUIRE(frame.blueCone.y + ROI.top == Approx(blueCone.y).margin(1.0));
+        REQUIRE(frame.yellowCandidates.largest().bottom + ROI.top == Approx(yellowCone.y + SyntheticScene::CONE_HEIGHT / 2.0f).margin(1.0));
+        REQUIRE(frame.yellowCone.x == Approx(yellowCone.x));
+        REQUIRE(frame.blueCandidates.count == 1);
+        REQUIRE(frame.yellowCandidates.count == 1);
+    }
+}
@@ -0,0 +1,62 @@
+#include "catch.hpp"
+#include "ConeDetector.hpp"
+#include "WorkerPool.hpp"
+
+#include <atomic>
+#include <random>
+#include <vector>
+
+TEST_CASE("A worker pool runs every task exactly once per run.")
+{
+    WorkerPool pool(3);
+    REQUIRE(pool.threads() == 4);
+    std::vector<std::atomic<int>> calls(10);
+    for (int run = 0; run < 1000; run++)
+    {
+        pool.run(calls.size(), [&calls](size_t task) { calls[task]++; });
+    }
+    for (const std::atomic<int> &count : calls)
+    {
+        REQUIRE(count.load() == 1000);
+    }
+}
+
+TEST_CASE("Parallel cone detection finds the same cones as serial detection.")
+{
+    // Cone-coloured rectangles of random size on a grey background; some cross the chunk borders.
+    std::mt19937 rng(11);
+    Frame serialFrame;
+    serialFrame.band.create(50, 640, CV_8UC4);
+    serialFrame.band.setTo(cv::Scalar(130, 130, 130, 0));
+    for (int cone = 0; cone < 20; cone++)
+    {
+        const cv::Scalar color = (cone % 2 == 0) ? cv::Scalar(190, 66, 34, 0) : cv::Scalar(86, 186, 230, 0);
+        const int top = static_cast<int>(rng() % 40);
+        const int left = static_cast<int>(rng() % 600);
+        serialFrame.band(cv::Range(top, top + 5 + static_cast<int>(rng() % 5)), cv::Range(left, left + 10 + static_cast<int>(rng() % 30))).setTo(color);
+    }
+    Frame parallelFrame;
+    parallelFrame.band = serialFrame.band.clone();
+
+    ConeDetector serial(640, 50, false, 6, false, 1);
+    ConeDetector parallel(640, 50, false, 6, false, 3);
+    serial.segment(serialFrame);
+    serial.detect(serialFrame);
+    parallel.segment(parallelFrame);
+    parallel.detect(parallelFrame);
+
+    REQUIRE(serialFrame.blueCandidates.count > 0);
+    REQUIRE(serialFrame.yellowCandidates.count > 0);
+    REQUIRE(serialFrame.blueMask.runCount() == parallelFrame.blueMask.runCount());
+    REQUIRE(serialFrame.yellowMask.runCount() == parallelFrame.yellowMask.runCount());
+    REQUIRE(serialFrame.blueCandidates.count == parallelFrame.blueCandidates.count);
+    REQUIRE(serialFrame.yellowCandidates.count == parallelFrame.yellowCandidates.count);
+    for (size_t i = 0; i < serialFrame.blueCandidates.count; i++)
+    {
+        REQUIRE(serialFrame.blueCandidates.items[i].area == parallelFrame.blueCandidates.items[i].area);
+    }
+    for (size_t i = 0; i < serialFrame.yellowCandidates.count; i++)
+    {
+        REQUIRE(serialFrame.yellowCandidates.items[i].area == parallelFrame.yellowCandidates.items[i].area);
+    }
+}
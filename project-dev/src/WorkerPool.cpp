@@ -0,0 +1,72 @@
+#include "WorkerPool.hpp"
+#include "SpscQueue.hpp"
+
+WorkerPool::WorkerPool(size_t workers)
+    : m_workers{}, m_run{0}, m_stop{false}, m_task{nullptr}, m_taskCount{0}
+{
+    for (size_t i = 0; i < workers; i++)
+    {
+        m_workers.emplace_back(new Worker{});
+    }
+    for (size_t i = 0; i < workers; i++)
+    {
+        m_workers[i]->thread = std::thread(&WorkerPool::work, this, i);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    m_stop.store(true, std::memory_order_release);
+    for (std::unique_ptr<Worker> &worker : m_workers)
+    {
+        worker->thread.join();
+    }
+}
+
+void WorkerPool::runTasks(size_t participant)
+{
+    for (size_t task = participant; task < m_taskCount; task += threads())
+    {
+        (*m_task)(task);
+    }
+}
+
+void WorkerPool::work(size_t worker)
+{
+    uint64_t lastRun = 0;
+    while (!m_stop.load(std::memory_order_acquire))
+    {
+        const uint64_t currentRun = m_run.load(std::memory_order_acquire);
+        if (currentRun == lastRun)
+        {
+            // Spin right after a run; between frames this quickly settles on sleeping.
+            for (unsigned int attempt = 0; m_run.load(std::memory_order_acquire) == lastRun && !m_stop.load(std::memory_order_acquire); attempt++)
+            {
+                backoff(attempt);
+            }
+            continue;
+        }
+        // Participant 0 is the thread calling run().
+        runTasks(worker + 1);
+        lastRun = currentRun;
+        m_workers[worker]->finishedRun.store(currentRun, std::memory_order_release);
+    }
+}
+
+void WorkerPool::run(size_t taskCount, const std::function<void(size_t)> &task)
+{
+    m_task = &task;
+    m_taskCount = taskCount;
+    const uint64_t currentRun = m_run.load(std::memory_order_relaxed) + 1;
+    m_run.store(currentRun, std::memory_order_release);
+
+    runTasks(0);
+    for (std::unique_ptr<Worker> &worker : m_workers)
+    {
+        for (unsigned int attempt = 0; worker->finishedRun.load(std::memory_order_acquire) != currentRun; attempt++)
+        {
+            backoff(attempt);
+        }
+    }
+    m_task = nullptr;
+}
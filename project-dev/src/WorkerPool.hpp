@@ -0,0 +1,47 @@
+#ifndef WORKERPOOL
+#define WORKERPOOL
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Small pool of persistent threads for fork-join parallelism inside one frame. run() hands out the tasks
+// round-robin to the workers and the calling thread and returns when all of them are done. Workers wait
+// for the next run() with a short spin before they back off to sleeping, so no thread is created per frame.
+// run() must only be called from one thread at a time.
+class WorkerPool
+{
+private:
+    struct Worker
+    {
+        std::thread thread{};
+        std::atomic<uint64_t> finishedRun{0};
+    };
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<uint64_t> m_run;
+    std::atomic<bool> m_stop;
+    const std::function<void(size_t)> *m_task;
+    size_t m_taskCount;
+
+    void work(size_t worker);
+    void runTasks(size_t participant);
+
+public:
+    // The pool executes tasks on workers + 1 threads, the calling thread included.
+    explicit WorkerPool(size_t workers);
+    ~WorkerPool();
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    size_t threads() const { return m_workers.size() + 1; }
+
+    // Calls task(i) for every i in [0, taskCount).
+    void run(size_t taskCount, const std::function<void(size_t)> &task);
+};
+
+#endif
@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2020  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cluon-complete.hpp"
+#include "ConeColorTable.hpp"
+#include "Evaluation.hpp"
+#include "H264Decoder.hpp"
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// The .rec files of a directory (or the file itself) with their sizes.
+std::vector<std::pair<std::string, off_t>> findRecordings(const std::string &path)
+{
+    std::vector<std::pair<std::string, off_t>> recordings;
+    struct stat status;
+    if (0 != stat(path.c_str(), &status))
+    {
+        return recordings;
+    }
+    if (!S_ISDIR(status.st_mode))
+    {
+        recordings.emplace_back(path, status.st_size);
+        return recordings;
+    }
+
+    DIR *directory = opendir(path.c_str());
+    if (nullptr == directory)
+    {
+        return recordings;
+    }
+    const std::string SUFFIX{".rec"};
+    for (dirent *entry = readdir(directory); nullptr != entry; entry = readdir(directory))
+    {
+        const std::string NAME{entry->d_name};
+        const std::string FILE_NAME{path + "/" + NAME};
+        if (NAME.size() > SUFFIX.size() && 0 == NAME.compare(NAME.size() - SUFFIX.size(), SUFFIX.size(), SUFFIX) &&
+            0 == stat(FILE_NAME.c_str(), &status) && S_ISREG(status.st_mode))
+        {
+            recordings.emplace_back(FILE_NAME, status.st_size);
+        }
+    }
+    closedir(directory);
+    return recordings;
+}
+
+int32_t main(int32_t argc, char **argv)
+{
+    int32_t retCode{1};
+    auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
+    if ((0 == commandlineArguments.count("recordings")) ||
+        (0 == commandlineArguments.count("width")) ||
+        (0 == commandlineArguments.count("height")))
+    {
+        std::cerr << argv[0] << " evaluates the steering accuracy of template-opencv on many recordings in parallel." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << " --recordings=<directory with .rec files or a single .rec file> --width=<width> --height=<height>" << std::endl;
+        std::cerr << "         --width:  width of the frames" << std::endl;
+        std::cerr << "         --height: height of the frames" << std::endl;
+        std::cerr << "         --roi-top, --roi-bottom, --roi-left, --roi-right: band of the frame to process (default: rows 310-360 of 480, scaled to --height, full width)" << std::endl;
+        std::cerr << "         --segmentation: 'lut' (default) or 'exact'" << std::endl;
+        std::cerr << "         --lut-bits: bits per colour channel of the lookup table, 8 is exact (default: 6)" << std::endl;
+        std::cerr << "         --no-tracking: steer with the cones as detected in each frame instead of tracking them" << std::endl;
+        std::cerr << "         --adaptive-roi: search only the neighbourhood of the cones of the last frame within the band, and all of it when a cone is lost" << std::endl;
+        std::cerr << "         --cones: 'largest' (default) steers for the largest cone of each colour, 'nearest' for the one closest to the car" << std::endl;
+        std::cerr << "         --rules: file of steering rules that replace the built-in rules of the directions it contains, see template-opencv" << std::endl;
+        std::cerr << "         --model: steer with a polynomial model fitted by train-steering-model instead of the rules" << std::endl;
+        std::cerr << "         --threads: recordings evaluated at the same time (default: number of cores)" << std::endl;
+        std::cerr << "Example: " << argv[0] << " --recordings=../recordings --width=640 --height=480" << std::endl;
+    }
+    else if (!H264Decoder::available())
+    {
+        std::cerr << argv[0] << ": The recordings cannot be decoded; rebuild with openh264 installed." << std::endl;
+    }
+    else
+    {
+        const uint32_t WIDTH{static_cast<uint32_t>(std::stoi(commandlineArguments["width"]))};
+        const uint32_t HEIGHT{static_cast<uint32_t>(std::stoi(commandlineArguments["height"]))};
+        const RegionOfInterest DEFAULT_ROI{defaultRegionOfInterest(WIDTH, HEIGHT)};
+        SteeringRules steeringRules{defaultSteeringRules()};
+        std::string rulesError;
+        const bool VALID_RULES{commandlineArguments.count("rules") == 0 || loadSteeringRules(commandlineArguments["rules"], steeringRules, rulesError)};
+        const bool POLYNOMIAL_MODEL{commandlineArguments.count("model") != 0};
+        PolynomialSteeringParameters modelParameters{};
+        std::string modelError;
+        const bool VALID_MODEL{!POLYNOMIAL_MODEL || loadSteeringModel(commandlineArguments["model"], modelParameters, modelError)};
+        const EvaluationSettings SETTINGS{
+            WIDTH,
+            HEIGHT,
+            RegionOfInterest{
+                (commandlineArguments.count("roi-top") != 0) ? std::stoi(commandlineArguments["roi-top"]) : DEFAULT_ROI.top,
+                (commandlineArguments.count("roi-bottom") != 0) ? std::stoi(commandlineArguments["roi-bottom"]) : DEFAULT_ROI.bottom,
+                (commandlineArguments.count("roi-left") != 0) ? std::stoi(commandlineArguments["roi-left"]) : 0,
+                (commandlineArguments.count("roi-right") != 0) ? std::stoi(commandlineArguments["roi-right"]) : static_cast<int>(WIDTH)},
+            ProcessingSettings{
+                commandlineArguments["segmentation"] == "exact",
+                (commandlineArguments.count("lut-bits") != 0) ? std::stoi(commandlineArguments["lut-bits"]) : 6,
+                1,
+                commandlineArguments["cones"] == "nearest" ? ConeSelection::NEAREST : ConeSelection::LARGEST,
+                commandlineArguments.count("no-tracking") == 0,
+                commandlineArguments.count("adaptive-roi") != 0,
+                false,
+                steeringRules,
+                POLYNOMIAL_MODEL,
+                modelParameters}};
+
+        if (!SETTINGS.roi.validFor(WIDTH, HEIGHT))
+        {
+            std::cerr << argv[0] << ": --roi-top, --roi-bottom, --roi-left and --roi-right must give 0 <= top < bottom <= " << HEIGHT
+                      << " and 0 <= left < right <= " << WIDTH << "." << std::endl;
+            return retCode;
+        }
+        if (!ConeColorTable::validBitsPerChannel(SETTINGS.processing.lutBits))
+        {
+            std::cerr << argv[0] << ": --lut-bits must be between " << ConeColorTable::MIN_BITS_PER_CHANNEL << " and "
+                      << ConeColorTable::MAX_BITS_PER_CHANNEL << "." << std::endl;
+            return retCode;
+        }
+        if (!VALID_RULES)
+        {
+            std::cerr << argv[0] << ": --rules: " << rulesError << "." << std::endl;
+            return retCode;
+        }
+        if (!VALID_MODEL)
+        {
+            std::cerr << argv[0] << ": --model: " << modelError << "." << std::endl;
+            return retCode;
+        }
+
+        auto recordings = findRecordings(commandlineArguments["recordings"]);
+        if (recordings.empty())
+        {
+            std::cerr << argv[0] << ": No recordings found in " << commandlineArguments["recordings"] << "." << std::endl;
+            return retCode;
+        }
+        // Start with the largest recordings so that the run takes about as long as the longest one.
+        std::sort(recordings.begin(), recordings.end(),
+                  [](const std::pair<std::string, off_t> &a, const std::pair<std::string, off_t> &b) { return a.second > b.second; });
+
+        const size_t CORES{std::max(1u, std::thread::hardware_concurrency())};
+        const size_t THREADS{std::min(recordings.size(),
+                                      (commandlineArguments.count("threads") != 0) ? static_cast<size_t>(std::max(1, std::stoi(commandlineArguments["threads"]))) : CORES)};
+        std::clog << argv[0] << ": Evaluating " << recordings.size() << " recordings on " << THREADS << " threads." << std::endl;
+
+        // Every thread takes the next recording that is not evaluated yet; each recording is processed
+        // independently with its own decoder, detector and estimator.
+        const auto START = std::chrono::steady_clock::now();
+        std::vector<EvaluationResult> results(recordings.size());
+        std::atomic<size_t> nextRecording{0};
+        auto evaluate = [&]()
+        {
+            for (size_t i = nextRecording++; i < recordings.size(); i = nextRecording++)
+            {
+                results[i] = evaluateRecording(recordings[i].first, SETTINGS);
+            }
+        };
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < THREADS; i++)
+        {
+            threads.emplace_back(evaluate);
+        }
+        evaluate();
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+        const double SECONDS{std::chrono::duration<double>(std::chrono::steady_clock::now() - START).count()};
+
+        // Report in the order of the file names.
+        std::sort(results.begin(), results.end(),
+                  [](const EvaluationResult &a, const EvaluationResult &b) { return a.recording < b.recording; });
+        EvaluationResult overall;
+        overall.valid = true;
+        for (const EvaluationResult &result : results)
+        {
+            if (!result.valid)
+            {
+                std::cout << result.recording << ": Could not be read." << std::endl;
+                overall.valid = false;
+                continue;
+            }
+            std::cout << result.recording << ": Percentage: " << std::to_string(result.accuracy())
+                      << "; Frames: " << result.frames << "; Nr Correct Angle: " << result.correctAngles;
+            if (result.skippedFrames > 0)
+            {
+                std::cout << "; Skipped: " << result.skippedFrames;
+            }
+            std::cout << "; " << std::to_string(result.seconds) << " s" << std::endl;
+            overall.frames += result.frames;
+            overall.correctAngles += result.correctAngles;
+        }
+        std::cout << "Percentage: " << std::to_string(overall.accuracy()) << std::endl;
+        std::cout << "Frames: " << overall.frames << std::endl;
+        std::cout << "Nr Correct Angle: " << overall.correctAngles << std::endl;
+        std::clog << argv[0] << ": Evaluated in " << std::to_string(SECONDS) << " s." << std::endl;
+        retCode = overall.valid ? 0 : 1;
+    }
+    return retCode;
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2020  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cluon-complete.hpp"
+#include "opendlv-standard-message-set.hpp"
+#include "FrameArchive.hpp"
+#include "SteeringEstimator.hpp"
+#include "SyntheticScene.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+// Publishes frames into a shared memory area and the matching ground truth on an OD4 session the same
+// way as the h264 decoder and the recording player do, at a fixed rate, so that template-opencv can be
+// load tested without the vehicle stack.
+int32_t main(int32_t argc, char **argv)
+{
+    int32_t retCode{1};
+    auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
+    if ((0 == commandlineArguments.count("cid")) ||
+        (0 == commandlineArguments.count("name")) ||
+        (0 == commandlineArguments.count("width")) ||
+        (0 == commandlineArguments.count("height")))
+    {
+        std::cerr << argv[0] << " publishes synthetic or archived ARGB frames into a shared memory area at a fixed rate." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << " --cid=<OD4 session> --name=<name of shared memory area> --width=<width> --height=<height> [--fps=<rate>] [--archive=<frame archive>]" << std::endl;
+        std::cerr << "         --cid:     CID of the OD4Session to publish the GroundSteeringRequest of every frame" << std::endl;
+        std::cerr << "         --name:    name of the shared memory area to create" << std::endl;
+        std::cerr << "         --width:   width of the frame" << std::endl;
+        std::cerr << "         --height:  height of the frame" << std::endl;
+        std::cerr << "         --fps:     frames per second (default: 60)" << std::endl;
+        std::cerr << "         --frames:  number of frames to publish, 0 runs until Ctrl-C (default: 0)" << std::endl;
+        std::cerr << "         --archive: replay a frame archive in a loop instead of drawing cones; pixels outside its region are black" << std::endl;
+        std::cerr << "         --roi-top, --roi-bottom, --roi-left, --roi-right: band in which the cones are drawn (default: rows 310-360 of 480, scaled to --height, full width)" << std::endl;
+        std::cerr << "Example: " << argv[0] << " --cid=253 --name=img --width=640 --height=480 --fps=120" << std::endl;
+    }
+    else
+    {
+        const std::string NAME{commandlineArguments["name"]};
+        const uint32_t WIDTH{static_cast<uint32_t>(std::stoi(commandlineArguments["width"]))};
+        const uint32_t HEIGHT{static_cast<uint32_t>(std::stoi(commandlineArguments["height"]))};
+        const RegionOfInterest DEFAULT_ROI{defaultRegionOfInterest(WIDTH, HEIGHT)};
+        const double FPS{(commandlineArguments.count("fps") != 0) ? std::stod(commandlineArguments["fps"]) : 60.0};
+        const uint64_t FRAMES{(commandlineArguments.count("frames") != 0) ? std::stoull(commandlineArguments["frames"]) : 0};
+        const RegionOfInterest ROI{
+            (commandlineArguments.count("roi-top") != 0) ? std::stoi(commandlineArguments["roi-top"]) : DEFAULT_ROI.top,
+            (commandlineArguments.count("roi-bottom") != 0) ? std::stoi(commandlineArguments["roi-bottom"]) : DEFAULT_ROI.bottom,
+            (commandlineArguments.count("roi-left") != 0) ? std::stoi(commandlineArguments["roi-left"]) : 0,
+            (commandlineArguments.count("roi-right") != 0) ? std::stoi(commandlineArguments["roi-right"]) : static_cast<int>(WIDTH)};
+
+        std::unique_ptr<FrameArchive> archive;
+        if (commandlineArguments.count("archive") != 0)
+        {
+            archive.reset(new FrameArchive{commandlineArguments["archive"]});
+            if (!archive->valid() || archive->frameCount() == 0 || archive->frameWidth() != WIDTH || archive->frameHeight() != HEIGHT)
+            {
+                std::cerr << argv[0] << ": " << commandlineArguments["archive"] << " is not a frame archive of " << WIDTH << "x" << HEIGHT << " frames." << std::endl;
+                return retCode;
+            }
+        }
+        else if (ROI.clampedTo(WIDTH, HEIGHT).width() <= SyntheticScene::CONE_WIDTH || ROI.clampedTo(WIDTH, HEIGHT).height() <= 0)
+        {
+            std::cerr << argv[0] << ": The band is too small for the cones." << std::endl;
+            return retCode;
+        }
+
+        const uint32_t SIZE{WIDTH * HEIGHT * 4};
+        std::unique_ptr<cluon::SharedMemory> sharedMemory{new cluon::SharedMemory{NAME, SIZE}};
+        if (!sharedMemory || !sharedMemory->valid())
+        {
+            std::cerr << argv[0] << ": Failed to create shared memory '" << NAME << "'." << std::endl;
+            return retCode;
+        }
+        std::clog << argv[0] << ": Created shared memory " << NAME << " (" << SIZE << " bytes) for an ARGB image (width = " << WIDTH << ", height = " << HEIGHT << ")." << std::endl;
+
+        cluon::OD4Session od4{static_cast<uint16_t>(std::stoi(commandlineArguments["cid"]))};
+
+        // The ground truth of the synthetic frames is what the steering rules make of the known cone
+        // positions, so a consumer that processes every frame should reach full accuracy.
+        SyntheticScene scene{WIDTH, HEIGHT, ROI};
+        SteeringEstimator estimator{scaledSteeringThresholds(DEFAULT_STEERING_THRESHOLDS, WIDTH)};
+        cv::Mat image(static_cast<int>(HEIGHT), static_cast<int>(WIDTH), CV_8UC4, cv::Scalar(0, 0, 0, 0));
+        Frame archived;
+
+        const std::chrono::nanoseconds PERIOD{static_cast<int64_t>(1e9 / FPS)};
+        auto deadline = std::chrono::steady_clock::now();
+        uint64_t lateFrames{0};
+        uint64_t frame{0};
+        for (; od4.isRunning() && (0 == FRAMES || frame < FRAMES); frame++)
+        {
+            float groundSteering;
+            if (archive)
+            {
+                archive->read(frame % archive->frameCount(), archive->region(), archived);
+                const RegionOfInterest REGION = archive->region();
+                cv::Mat target = image(cv::Range(REGION.top, REGION.bottom), cv::Range(REGION.left, REGION.right));
+                archived.band.copyTo(target);
+                groundSteering = archived.groundSteering;
+            }
+            else
+            {
+                cv::Point2f blueCone;
+                cv::Point2f yellowCone;
+                scene.render(frame, image, blueCone, yellowCone);
+                groundSteering = static_cast<float>(estimator.estimate(blueCone, yellowCone));
+            }
+
+            // Publish the ground truth first so that it has arrived when the consumer wakes up.
+            const cluon::data::TimeStamp NOW{cluon::time::now()};
+            opendlv::proxy::GroundSteeringRequest gsr;
+            gsr.groundSteering(groundSteering);
+            od4.send(gsr, NOW);
+
+            sharedMemory->lock();
+            sharedMemory->setTimeStamp(NOW);
+            std::memcpy(sharedMemory->data(), image.data, SIZE);
+            sharedMemory->unlock();
+            sharedMemory->notifyAll();
+
+            deadline += PERIOD;
+            const auto AFTER = std::chrono::steady_clock::now();
+            if (AFTER > deadline)
+            {
+                // Keep the rate instead of trying to catch up with a burst of frames.
+                lateFrames++;
+                deadline = AFTER;
+            }
+            std::this_thread::sleep_until(deadline);
+        }
+        std::clog << argv[0] << ": Published " << frame << " frames, " << lateFrames << " of them late." << std::endl;
+        retCode = 0;
+    }
+    return retCode;
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2020  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cluon-complete.hpp"
+#include "SteeringLog.hpp"
+
+#include <fstream>
+#include <iostream>
+
+// Converts the binary steering log written by template-opencv into the CSV layout used for analysis.
+int32_t main(int32_t argc, char **argv)
+{
+    int32_t retCode{1};
+    auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
+    if (0 == commandlineArguments.count("log"))
+    {
+        std::cerr << argv[0] << " converts a binary steering log into CSV." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << " --log=<binary steering log> [--csv=<output file>] [--blobs]" << std::endl;
+        std::cerr << "         --log:   steering log written by template-opencv" << std::endl;
+        std::cerr << "         --csv:   file to write, default is stdout" << std::endl;
+        std::cerr << "         --blobs: add the cone positions, areas and number of blobs per colour" << std::endl;
+        std::cerr << "Example: " << argv[0] << " --log=../steering.log --csv=../test.csv" << std::endl;
+    }
+    else
+    {
+        std::vector<SteeringRecord> records;
+        if (!readSteeringLog(commandlineArguments["log"], records))
+        {
+            std::cerr << argv[0] << ": " << commandlineArguments["log"] << " is not a steering log." << std::endl;
+            return retCode;
+        }
+
+        const bool WITH_BLOBS{commandlineArguments.count("blobs") != 0};
+        if (commandlineArguments.count("csv") != 0)
+        {
+            std::ofstream csv(commandlineArguments["csv"]);
+            writeSteeringCsv(csv, records, WITH_BLOBS);
+        }
+        else
+        {
+            writeSteeringCsv(std::cout, records, WITH_BLOBS);
+        }
+        std::clog << argv[0] << ": Converted " << records.size() << " records." << std::endl;
+        retCode = 0;
+    }
+    return retCode;
+}
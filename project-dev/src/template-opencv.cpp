@@ -19,39 +19,41 @@
 #include "cluon-complete.hpp"
 // Include the OpenDLV Standard Message Set that contains messages that are usually exchanged for automotive or robotic applications
 #include "opendlv-standard-message-set.hpp"
+#include "CatchUpPolicy.hpp"
+#include "Evaluation.hpp"
+#include "FrameAcquisition.hpp"
+#include "FrameArchive.hpp"
+#include "FramePipeline.hpp"
+#include "FrameProcessor.hpp"
+#include "FrameTiming.hpp"
+#include "FrameWorkspace.hpp"
+#include "LatencyHistogram.hpp"
+#include "RecordingSource.hpp"
+#include "SteeringLog.hpp"
+#include "SteeringOutput.hpp"
+#include "SteeringPublisher.hpp"
 
 // Include the GUI and image processing header files from OpenCV
 #include <opencv2/highgui/highgui.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
 #include <opencv2/features2d.hpp>
 
+#include <atomic>
+#include <csignal>
+
 /*---------------- Global variables ---------------------*/
 
-// Yellow hsv values
-const int MIN_HUE_Y = 15; 
-const int MAX_HUE_Y = 25;  
-const int MIN_SAT_Y = 75;  
-const int MAX_SAT_Y = 185; 
-const int MIN_VAL_Y = 147; 
-const int MAX_VAL_Y = 255; 
-
-// Blue hsv values
-const int MIN_HUE_B = 100; 
-const int MAX_HUE_B = 140; 
-const int MIN_SAT_B = 120; 
-const int MAX_SAT_B = 255; 
-const int MIN_VAL_B = 40;  
-const int MAX_VAL_B = 255; 
-
-// Car's position and thresholds
-const int CAR_POSITION = 240;
-const int LEFT_THRESHOLD = 120;
-const int RIGHT_THRESHOLD = 360;
-
-/*---------------- Function definitions ---------------------*/
-cv::Point2f  drawContourWithCentroidPoint(cv::Mat inputImage,cv::Mat outputImage, int contourArea, cv::Scalar contourColor, cv::Scalar centroidColor);
-double calculateSteeringWheelAngle(cv::Point2f blueCone, cv::Point2f yellowCone,int timestamp);
-double calculateSteeringWheelAngleCounter(cv::Point2f blueCone, cv::Point2f yellowCone,int timestamp);
+// Frames queued between the stages, in addition to one per stage, when the stages run on their own
+// threads and the catch-up policy is 'backlog'
+const size_t PIPELINE_BACKLOG = 2;
+
+// Set by SIGUSR1 to print the latencies measured so far.
+std::atomic<bool> latencyReportRequested{false};
+
+void requestLatencyReport(int)
+{
+    latencyReportRequested.store(true);
+}
 
 /*---------------- Main program ---------------------*/
 
@@ -60,8 +62,10 @@ int32_t main(int32_t argc, char **argv)
     int32_t retCode{1};
     // Parse the command line parameters as we require the user to specify some mandatory information on startup.
     auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
-    if ((0 == commandlineArguments.count("cid")) ||
-        (0 == commandlineArguments.count("name")) ||
+    if (((0 == commandlineArguments.count("rec")) &&
+         (0 == commandlineArguments.count("archive")) &&
+         ((0 == commandlineArguments.count("cid")) ||
+          (0 == commandlineArguments.count("name")))) ||
         (0 == commandlineArguments.count("width")) ||
         (0 == commandlineArguments.count("height")))
     {
@@ -71,30 +75,160 @@ int32_t main(int32_t argc, char **argv)
         std::cerr << "         --name:   name of the shared memory area to attach" << std::endl;
         std::cerr << "         --width:  width of the frame" << std::endl;
         std::cerr << "         --height: height of the frame" << std::endl;
+        std::cerr << "         --rec:    evaluate a recording offline as fast as possible instead of attaching to the shared memory (needs openh264)" << std::endl;
+        std::cerr << "         --archive: replay a frame archive written with --record instead of attaching to the shared memory" << std::endl;
+        std::cerr << "         --record: write the frames with their timestamps and ground truth to a frame archive" << std::endl;
+        std::cerr << "         --record-band: store only the band in the frame archive instead of the whole frame" << std::endl;
+        std::cerr << "         --roi-top, --roi-bottom, --roi-left, --roi-right: band of the frame to process (default: rows 310-360 of 480, scaled to --height, full width)" << std::endl;
+        std::cerr << "         --adaptive-roi: search only the neighbourhood of the cones of the last frame within the band, and all of it when a cone is lost" << std::endl;
+        std::cerr << "         --segmentation: 'lut' (default) classifies pixels with a colour lookup table, 'exact' converts every pixel to HSV" << std::endl;
+        std::cerr << "         --lut-bits: bits per colour channel of the lookup table, 8 is exact (default: 6)" << std::endl;
+        std::cerr << "         --full-frame: copy the whole frame out of the shared memory instead of only the band (implied by --verbose)" << std::endl;
+        std::cerr << "         --detection-threads: threads that segment the band and extract the blue and yellow cones concurrently, at most 16 (default: 1)" << std::endl;
+        std::cerr << "         --pipeline: run acquisition, segmentation, detection, estimation and output on their own threads" << std::endl;
+        std::cerr << "         --catch-up: when frames take longer than a frame period, 'latest' only processes the newest frame, 'backlog' (default)" << std::endl;
+        std::cerr << "                     queues up to --backlog frames between the stages and 'degrade' skips the debug drawing and segments" << std::endl;
+        std::cerr << "                     every other row for a while after frames were dropped; without --pipeline there is no queue," << std::endl;
+        std::cerr << "                     so 'backlog' acts like 'latest' and may only be given with --pipeline" << std::endl;
+        std::cerr << "         --frame-period: microseconds between the frames of the producer, to count dropped frames (default: learned from the first frames)" << std::endl;
+        std::cerr << "         --backlog: frames queued between the stages with --catch-up=backlog, needs --pipeline (default: 2)" << std::endl;
+        std::cerr << "         --flush-frames: flush the 'Group 15' lines to stdout every N frames, 0 only when the buffer is full and on exit (default: 1, 0 with --rec and --archive)" << std::endl;
+        std::cerr << "         --flush-ms: additionally flush them when this many milliseconds have passed (default: 0, off)" << std::endl;
+        std::cerr << "         --log: binary steering log, convert it with steering-log-to-csv (default: ../steering.log)" << std::endl;
+        std::cerr << "         --publish: send the calculated angle as GroundSteeringRequest to the OD4Session with the sample timestamp of the frame" << std::endl;
+        std::cerr << "         --sender-stamp: sender stamp of the published GroundSteeringRequest, which is not used as ground truth (default: 1)" << std::endl;
+        std::cerr << "         --rules: file of steering rules that replace the built-in rules of the directions it contains" << std::endl;
+        std::cerr << "                  (one '<clockwise|counter-clockwise> <blue|yellow> <lower> <upper> <angle>' per line, see SteeringRules.hpp)" << std::endl;
+        std::cerr << "         --cones: 'largest' (default) steers for the largest cone of each colour, 'nearest' for the one closest to the car" << std::endl;
+        std::cerr << "         --no-tracking: steer with the cones as detected in each frame instead of tracking them across frames" << std::endl;
+        std::cerr << "         --model: steer with a polynomial model fitted by train-steering-model instead of the rules" << std::endl;
+        std::cerr << "         The latencies of the processing stages, the age of the frames when their steering angle is" << std::endl;
+        std::cerr << "         emitted and the number of skipped frames are printed on exit and on SIGUSR1." << std::endl;
         std::cerr << "Example: " << argv[0] << " --cid=253 --name=img --width=640 --height=480 --verbose" << std::endl;
+        std::cerr << "         " << argv[0] << " --rec=recording.rec --width=640 --height=480" << std::endl;
+        std::cerr << "         " << argv[0] << " --cid=253 --name=img --width=640 --height=480 --record=frames.archive" << std::endl;
     }
     else
     {
         // Extract the values from the command line parameters
         const std::string NAME{commandlineArguments["name"]};
+        const std::string REC{commandlineArguments["rec"]};
+        const std::string ARCHIVE{commandlineArguments["archive"]};
+        const bool OFFLINE{!REC.empty() || !ARCHIVE.empty()};
+        const std::string RECORD{commandlineArguments["record"]};
+        const bool RECORD_BAND{commandlineArguments.count("record-band") != 0};
         const uint32_t WIDTH{static_cast<uint32_t>(std::stoi(commandlineArguments["width"]))};
         const uint32_t HEIGHT{static_cast<uint32_t>(std::stoi(commandlineArguments["height"]))};
+        const RegionOfInterest DEFAULT_ROI{defaultRegionOfInterest(WIDTH, HEIGHT)};
         const bool VERBOSE{commandlineArguments.count("verbose") != 0};
+        const RegionOfInterest ROI{
+            (commandlineArguments.count("roi-top") != 0) ? std::stoi(commandlineArguments["roi-top"]) : DEFAULT_ROI.top,
+            (commandlineArguments.count("roi-bottom") != 0) ? std::stoi(commandlineArguments["roi-bottom"]) : DEFAULT_ROI.bottom,
+            (commandlineArguments.count("roi-left") != 0) ? std::stoi(commandlineArguments["roi-left"]) : 0,
+            (commandlineArguments.count("roi-right") != 0) ? std::stoi(commandlineArguments["roi-right"]) : static_cast<int>(WIDTH)};
+        // The whole frame is only needed to display it.
+        const bool FULL_FRAME{VERBOSE || commandlineArguments.count("full-frame") != 0 || (!RECORD.empty() && !RECORD_BAND)};
+        const bool ADAPTIVE_ROI{commandlineArguments.count("adaptive-roi") != 0};
+        const bool EXACT_SEGMENTATION{commandlineArguments["segmentation"] == "exact"};
+        const int LUT_BITS{(commandlineArguments.count("lut-bits") != 0) ? std::stoi(commandlineArguments["lut-bits"]) : 6};
+        const bool PIPELINE{commandlineArguments.count("pipeline") != 0};
+        const bool TRACKING{commandlineArguments.count("no-tracking") == 0};
+        const ConeSelection CONE_SELECTION{commandlineArguments["cones"] == "nearest" ? ConeSelection::NEAREST : ConeSelection::LARGEST};
+        CatchUpPolicy catchUpPolicy{CatchUpPolicy::BACKLOG};
+        const bool VALID_CATCH_UP{commandlineArguments.count("catch-up") == 0 || parseCatchUpPolicy(commandlineArguments["catch-up"], catchUpPolicy)};
+        const int64_t FRAME_PERIOD{(commandlineArguments.count("frame-period") != 0) ? std::stoll(commandlineArguments["frame-period"]) : 0};
+        const int BACKLOG{(commandlineArguments.count("backlog") != 0) ? std::stoi(commandlineArguments["backlog"]) : static_cast<int>(PIPELINE_BACKLOG)};
+        const int DETECTION_THREADS{(commandlineArguments.count("detection-threads") != 0) ? std::stoi(commandlineArguments["detection-threads"]) : 1};
+        const FlushPolicy FLUSH_POLICY{
+            (commandlineArguments.count("flush-frames") != 0) ? static_cast<size_t>(std::stoi(commandlineArguments["flush-frames"])) : (OFFLINE ? 0 : 1),
+            std::chrono::milliseconds((commandlineArguments.count("flush-ms") != 0) ? std::stoi(commandlineArguments["flush-ms"]) : 0)};
+        const std::string LOG_FILE{(commandlineArguments.count("log") != 0) ? commandlineArguments["log"] : "../steering.log"};
+        const bool PUBLISH{commandlineArguments.count("publish") != 0};
+        const uint32_t SENDER_STAMP{(commandlineArguments.count("sender-stamp") != 0) ? static_cast<uint32_t>(std::stoul(commandlineArguments["sender-stamp"])) : 1};
+        SteeringRules steeringRules{defaultSteeringRules()};
+        std::string rulesError;
+        const bool VALID_RULES{commandlineArguments.count("rules") == 0 || loadSteeringRules(commandlineArguments["rules"], steeringRules, rulesError)};
+        const bool POLYNOMIAL_MODEL{commandlineArguments.count("model") != 0};
+        PolynomialSteeringParameters modelParameters{};
+        std::string modelError;
+        const bool VALID_MODEL{!POLYNOMIAL_MODEL || loadSteeringModel(commandlineArguments["model"], modelParameters, modelError)};
+
+        if (!ROI.validFor(WIDTH, HEIGHT))
+        {
+            std::cerr << argv[0] << ": --roi-top, --roi-bottom, --roi-left and --roi-right must give 0 <= top < bottom <= " << HEIGHT
+                      << " and 0 <= left < right <= " << WIDTH << "." << std::endl;
+            return retCode;
+        }
+        if (!VALID_CATCH_UP)
+        {
+            std::cerr << argv[0] << ": --catch-up must be 'latest', 'backlog' or 'degrade'." << std::endl;
+            return retCode;
+        }
+        // Serially only one frame is in flight, so there is nothing to queue.
+        if (!PIPELINE && (commandlineArguments.count("backlog") != 0 || (commandlineArguments.count("catch-up") != 0 && catchUpPolicy == CatchUpPolicy::BACKLOG)))
+        {
+            std::cerr << argv[0] << ": --catch-up=backlog and --backlog need --pipeline." << std::endl;
+            return retCode;
+        }
+        if (BACKLOG < 1)
+        {
+            std::cerr << argv[0] << ": --backlog must be at least 1." << std::endl;
+            return retCode;
+        }
+        if (DETECTION_THREADS < 1 || DETECTION_THREADS > MAX_DETECTION_THREADS)
+        {
+            std::cerr << argv[0] << ": --detection-threads must be between 1 and " << MAX_DETECTION_THREADS << "." << std::endl;
+            return retCode;
+        }
+        if (!ConeColorTable::validBitsPerChannel(LUT_BITS))
+        {
+            std::cerr << argv[0] << ": --lut-bits must be between " << ConeColorTable::MIN_BITS_PER_CHANNEL << " and "
+                      << ConeColorTable::MAX_BITS_PER_CHANNEL << "." << std::endl;
+            return retCode;
+        }
+        if (!VALID_RULES)
+        {
+            std::cerr << argv[0] << ": --rules: " << rulesError << "." << std::endl;
+            return retCode;
+        }
+        if (!VALID_MODEL)
+        {
+            std::cerr << argv[0] << ": --model: " << modelError << "." << std::endl;
+            return retCode;
+        }
+        if (PUBLISH && OFFLINE)
+        {
+            std::cerr << argv[0] << ": --publish needs an OD4Session and cannot be used with --rec or --archive." << std::endl;
+            return retCode;
+        }
+        if (!REC.empty() && !H264Decoder::available())
+        {
+            std::cerr << argv[0] << ": --rec needs the h264 decoder; rebuild with openh264 installed." << std::endl;
+            return retCode;
+        }
 
-        // Attach to the shared memory.
-        std::unique_ptr<cluon::SharedMemory> sharedMemory{new cluon::SharedMemory{NAME}};
-        if (sharedMemory && sharedMemory->valid())
+        // Attach to the shared memory, unless the frames are read from a recording.
+        std::unique_ptr<cluon::SharedMemory> sharedMemory{OFFLINE ? nullptr : new cluon::SharedMemory{NAME}};
+        if (OFFLINE || (sharedMemory && sharedMemory->valid()))
         {
-            std::clog << argv[0] << ": Attached to shared memory '" << sharedMemory->name() << " (" << sharedMemory->size() << " bytes)." << std::endl;
+            if (sharedMemory)
+            {
+                std::clog << argv[0] << ": Attached to shared memory '" << sharedMemory->name() << " (" << sharedMemory->size() << " bytes)." << std::endl;
+            }
 
             // Interface to a running OpenDaVINCI session where network messages are exchanged.
-            // The instance od4 allows you to send and receive messages.
-            cluon::OD4Session od4{static_cast<uint16_t>(std::stoi(commandlineArguments["cid"]))};
+            // The instance od4 allows you to send and receive messages. It is not needed offline.
+            std::unique_ptr<cluon::OD4Session> od4{OFFLINE ? nullptr : new cluon::OD4Session{static_cast<uint16_t>(std::stoi(commandlineArguments["cid"]))}};
 
             opendlv::proxy::GroundSteeringRequest gsr;
             std::mutex gsrMutex;
-            auto onGroundSteeringRequest = [&gsr, &gsrMutex](cluon::data::Envelope &&env)
+            auto onGroundSteeringRequest = [&gsr, &gsrMutex, PUBLISH, SENDER_STAMP](cluon::data::Envelope &&env)
             {
+                // Our own steering requests are not the ground truth.
+                if (PUBLISH && env.senderStamp() == SENDER_STAMP)
+                {
+                    return;
+                }
                 // The envelope data structure provide further details, such as sampleTimePoint as shown in this test case:
                 // https://github.com/chrberger/libcluon/blob/master/libcluon/testsuites/TestEnvelopeConverter.cpp#L31-L40
                 std::lock_guard<std::mutex> lck(gsrMutex);
@@ -102,293 +236,287 @@ int32_t main(int32_t argc, char **argv)
                 // std::cout << "lambda: groundSteering = " << gsr.groundSteering() << std::endl;
             };
 
-            od4.dataTrigger(opendlv::proxy::GroundSteeringRequest::ID(), onGroundSteeringRequest);
+            if (od4)
+            {
+                od4->dataTrigger(opendlv::proxy::GroundSteeringRequest::ID(), onGroundSteeringRequest);
+            }
 
-            std::ofstream myFile("../test.csv");
+            // The records are written to disk on a background thread; steering-log-to-csv turns them into
+            // the CSV used for the analysis.
+            SteeringLog steeringLog{LOG_FILE};
+            if (!steeringLog.isOpen())
+            {
+                std::cerr << argv[0] << ": Could not open the steering log " << LOG_FILE << "." << std::endl;
+            }
 
-            // print to csv
-             myFile << "Timestamp " << ",";
-            myFile << "GroundSteeringRequest " << ",";
-            myFile << "Calculated Angle";
-            myFile << "\n";
+            // The stages of the frame processing; every frame is acquired, segmented, searched for cones,
+            // turned into a steering wheel angle and emitted. Their buffers are allocated once and reused.
+            FrameAcquisition acquisition{WIDTH, HEIGHT, ROI, FULL_FRAME};
+            const ProcessingSettings PROCESSING{EXACT_SEGMENTATION, LUT_BITS, static_cast<size_t>(DETECTION_THREADS), CONE_SELECTION, TRACKING, ADAPTIVE_ROI, VERBOSE,
+                                                steeringRules, POLYNOMIAL_MODEL, modelParameters};
+            FrameProcessor processor{acquisition.roi(), PROCESSING, makeSteeringModel(PROCESSING, WIDTH)};
+            const ConeDetector &detector = processor.detector();
+            std::unique_ptr<RecordingSource> recording{REC.empty() ? nullptr : new RecordingSource{REC, acquisition}};
+            if (recording && !recording->valid())
+            {
+                std::cerr << argv[0] << ": Could not read the recording " << REC << "." << std::endl;
+                return retCode;
+            }
+            std::unique_ptr<FrameArchive> archive{ARCHIVE.empty() ? nullptr : new FrameArchive{ARCHIVE}};
+            if (archive)
+            {
+                const RegionOfInterest STORED = archive->region();
+                const RegionOfInterest &PROCESSED = acquisition.roi();
+                if (!archive->valid() || archive->frameWidth() != WIDTH || archive->frameHeight() != HEIGHT ||
+                    PROCESSED.top < STORED.top || PROCESSED.bottom > STORED.bottom || PROCESSED.left < STORED.left || PROCESSED.right > STORED.right)
+                {
+                    std::cerr << argv[0] << ": " << ARCHIVE << " is not a frame archive of " << WIDTH << "x" << HEIGHT << " frames containing the band." << std::endl;
+                    return retCode;
+                }
+                // Whole frames can only be recorded from an archive that holds them.
+                if (!RECORD.empty() && !RECORD_BAND &&
+                    (STORED.top != 0 || STORED.bottom != static_cast<int>(HEIGHT) || STORED.left != 0 || STORED.right != static_cast<int>(WIDTH)))
+                {
+                    std::cerr << argv[0] << ": " << ARCHIVE << " holds only part of the frames; use --record-band to record from it." << std::endl;
+                    return retCode;
+                }
+                std::clog << argv[0] << ": Replaying " << archive->frameCount() << " frames from " << ARCHIVE << "." << std::endl;
+            }
+            size_t archiveFrame = 0;
+            const RegionOfInterest FULL_FRAME_REGION{0, static_cast<int>(HEIGHT), 0, static_cast<int>(WIDTH)};
+            std::unique_ptr<FrameArchiveWriter> archiveWriter{RECORD.empty() ? nullptr : new FrameArchiveWriter{RECORD, WIDTH, HEIGHT, RECORD_BAND ? acquisition.roi() : FULL_FRAME_REGION}};
+            if (archiveWriter && !archiveWriter->isOpen())
+            {
+                std::cerr << argv[0] << ": Could not open the frame archive " << RECORD << "." << std::endl;
+                return retCode;
+            }
+            if (detector.colorTableSize() > 0)
+            {
+                std::clog << argv[0] << ": Using a " << detector.colorTableSize() << " bytes colour lookup table." << std::endl;
+            }
+
+            SteeringOutput steeringOutput{std::cout, FLUSH_POLICY};
+            std::unique_ptr<SteeringPublisher> publisher{PUBLISH ? new SteeringPublisher{static_cast<uint16_t>(std::stoi(commandlineArguments["cid"])), SENDER_STAMP} : nullptr};
+
+            // Every histogram is recorded by the thread of a single stage.
+            LatencyProfile latencies;
+            LatencyHistogram &waitLatency = latencies.add("wait");
+            LatencyHistogram &lockLatency = latencies.add("lock");
+            LatencyHistogram &copyLatency = latencies.add(OFFLINE ? "read" : "copy");
+            LatencyHistogram &recordLatency = latencies.add("record");
+            LatencyHistogram &segmentationLatency = latencies.add("segmentation");
+            LatencyHistogram &blobLatency = latencies.add("blobs");
+            LatencyHistogram &steeringLatency = latencies.add("steering");
+            LatencyHistogram &loggingLatency = latencies.add("logging");
+            LatencyHistogram &outputLatency = latencies.add("output");
+            // Time from the sample timestamp of the producer until the steering angle is emitted (online only).
+            LatencyHistogram &frameAge = latencies.add("frame age");
+            // Frames the producer wrote while we were busy or woke up late, by catch-up policy.
+            std::atomic<uint64_t> &droppedFrames = latencies.addCounter(std::string("Frames dropped (") + catchUpPolicyName(catchUpPolicy) + ")");
+            std::atomic<uint64_t> &repeatedFrames = latencies.addCounter("Frames repeated");
+            std::atomic<uint64_t> &degradedFrames = latencies.addCounter("Frames degraded");
+            FrameTiming frameTiming{FRAME_PERIOD};
+            CatchUp catchUp{catchUpPolicy};
+            std::signal(SIGUSR1, requestLatencyReport);
 
             // variables
             double NrOfCorrectAngle = 0;
-            double NrOfCorrectAngleCounter = 0;
             double frames = 0;
-            double calculatedAngle;
-            cv::Point2f previousBluecone;
-            cv::Point2f previousYellowCone;
-            double previousCalculatedAngle;
 
-            // Endless loop; end the program by pressing Ctrl-C.
-            while (od4.isRunning())
+            auto acquire = [&](Frame &frame)
             {
-                // OpenCV data structure to hold an image.
-                cv::Mat img;
-                cv::Mat cropedImg;
-                cv::Mat hsvImg;        // HSV Image
-                cv::Mat blueThreshImg; //  blue Thresh Image
-                cv::Mat yellowThreshImg;
-
-                // Wait for a notification of a new frame.
-                sharedMemory->wait();
-
-                // Lock the shared memory.
-                sharedMemory->lock();
+                StopWatch watch;
+                // Offline, the frames and the ground truth come straight from the recording.
+                if (recording)
                 {
-                    // Copy the pixels from the shared memory into our own data structure.
-                    cv::Mat wrapped(HEIGHT, WIDTH, CV_8UC4, sharedMemory->data());
-                    img = wrapped.clone();
+                    const bool HAS_FRAME = recording->next(frame);
+                    watch.lap(copyLatency);
+                    return HAS_FRAME;
                 }
-            
-                auto [_, ts] = sharedMemory->getTimeStamp();
-                auto ms = static_cast<int64_t>(ts.seconds()) * static_cast<int64_t>(1000 * 1000) + static_cast<int64_t>(ts.microseconds());
-                std::string output = "TS: " + std::to_string(ms) + "; GROUND STEERING: " + std::to_string(gsr.groundSteering());
-
-                sharedMemory->unlock();
-                cropedImg = img(cv::Range(310, 360), cv::Range(0, 640));
-                cv::cvtColor(cropedImg, hsvImg, CV_BGR2HSV); // Convert Original Image to HSV Thresh Image
-
-                cv::inRange(hsvImg, cv::Scalar(MIN_HUE_B, MIN_SAT_B, MIN_VAL_B), cv::Scalar(MAX_HUE_B, MAX_SAT_B, MAX_VAL_B), blueThreshImg);
-                cv::inRange(hsvImg, cv::Scalar(MIN_HUE_Y, MIN_SAT_Y, MIN_VAL_Y), cv::Scalar(MAX_HUE_Y, MAX_SAT_Y, MAX_VAL_Y), yellowThreshImg);
-                cv::Scalar blue = cv::Scalar(255,0,0);
-                cv::Scalar red = cv::Scalar(0,0,255);
-                cv::Scalar green = cv::Scalar(0,255,0);
-
-
-                cv::Point2f blueCone = drawContourWithCentroidPoint(blueThreshImg,cropedImg,75,blue,red);
-                cv::Point2f yellowCone = drawContourWithCentroidPoint(yellowThreshImg,cropedImg,75,green,red);
-
-                // checking the direction
-                if(previousBluecone.x > 0){
-                    if(previousBluecone.x > blueCone.x){
-                        // moving to the right counter clockwise
-                        calculatedAngle = calculateSteeringWheelAngle(blueCone, yellowCone, ms);
-                    } else {
-                        // moving to the left clockwise
-                        calculatedAngle = calculateSteeringWheelAngleCounter(blueCone,  yellowCone, ms);
+                // A frame archive is replayed in place from its memory mapping.
+                if (archive)
+                {
+                    if (archiveFrame == archive->frameCount())
+                    {
+                        return false;
+                    }
+                    archive->read(archiveFrame++, acquisition.roi(), frame);
+                    watch.lap(copyLatency);
+                    return true;
+                }
+
+                for (;;)
+                {
+                    // Endless loop; end the program by pressing Ctrl-C.
+                    if (!od4->isRunning())
+                    {
+                        return false;
+                    }
+
+                    // Wait for a notification of a new frame.
+                    sharedMemory->wait();
+                    watch.lap(waitLatency);
+
+                    // Lock the shared memory.
+                    sharedMemory->lock();
+                    watch.lap(lockLatency);
+
+                    auto [_, ts] = sharedMemory->getTimeStamp();
+                    const int64_t SAMPLE_TIME_STAMP{static_cast<int64_t>(ts.seconds()) * static_cast<int64_t>(1000 * 1000) + static_cast<int64_t>(ts.microseconds())};
+
+                    // Gaps in the timestamps are frames the producer wrote while we were not waiting.
+                    const int64_t PERIODS = frameTiming.next(SAMPLE_TIME_STAMP);
+                    if (PERIODS == 0)
+                    {
+                        // The previous frame again; nothing to copy or process.
+                        sharedMemory->unlock();
+                        repeatedFrames.fetch_add(1, std::memory_order_relaxed);
+                        watch.start();
+                        continue;
+                    }
+                    if (PERIODS > 1)
+                    {
+                        droppedFrames.fetch_add(static_cast<uint64_t>(PERIODS - 1), std::memory_order_relaxed);
+                    }
+
+                    {
+                        // Copy the pixels from the shared memory into our own data structure;
+                        // only the processed band is copied unless the full frame is needed.
+                        acquisition.copyFrom(sharedMemory->data(), frame);
+                    }
+                    frame.sampleTimeStamp = SAMPLE_TIME_STAMP;
+
+                    sharedMemory->unlock();
 
+                    frame.degraded = catchUp.degrade(PERIODS);
+                    if (frame.degraded)
+                    {
+                        degradedFrames.fetch_add(1, std::memory_order_relaxed);
                     }
-                } 
-                else if(previousYellowCone.x > 0){
-                    if(previousYellowCone.x > yellowCone.x){
-                         // moving to the right clockwise
-                        calculatedAngle = calculateSteeringWheelAngleCounter(blueCone,  yellowCone, ms);
-                    } else {
-                        // moving to the left counter clockwise
-                        calculatedAngle = calculateSteeringWheelAngle(blueCone, yellowCone, ms);
-                     }
-                } else {
-                    // if we don't know the direction we just assume the steering wheel angle to be 0.
-                    calculatedAngle = previousCalculatedAngle;
+
+                    // The ground truth travels with the frame it belongs to.
+                    {
+                        std::lock_guard<std::mutex> lck(gsrMutex);
+                        frame.groundSteering = gsr.groundSteering();
+                    }
+                    watch.lap(copyLatency);
+                    return true;
                 }
-                
-                // assign the values to the variables
-                previousBluecone = blueCone;
-                previousYellowCone = yellowCone;
-                previousCalculatedAngle = calculatedAngle;
-                frames++;  
+            };
+
+            auto record = [&archiveWriter, &recordLatency, RECORD_BAND](Frame &frame)
+            {
+                StopWatch watch;
+                archiveWriter->append(RECORD_BAND ? frame.band : frame.image, frame.sampleTimeStamp, frame.groundSteering);
+                watch.lap(recordLatency);
+            };
+
+            auto segment = [&processor, &segmentationLatency](Frame &frame)
+            {
+                StopWatch watch;
+                processor.segment(frame);
+                watch.lap(segmentationLatency);
+            };
+
+            auto detect = [&processor, &blobLatency](Frame &frame)
+            {
+                StopWatch watch;
+                processor.detect(frame);
+                watch.lap(blobLatency);
+            };
+
+            auto estimate = [&processor, &steeringLatency](Frame &frame)
+            {
+                StopWatch watch;
+                processor.estimate(frame);
+                watch.lap(steeringLatency);
+            };
+
+            auto emit = [&](Frame &frame)
+            {
+                StopWatch watch;
+                const int64_t ms = frame.sampleTimeStamp;
+                const double calculatedAngle = frame.calculatedAngle;
+                frames++;
 
                 // check if the calculated angle within 0.05 deviation
-                if(calculatedAngle < gsr.groundSteering() + 0.05 && calculatedAngle > gsr.groundSteering() - 0.05 ){
+                if (isCorrectAngle(calculatedAngle, frame.groundSteering))
+                {
                     NrOfCorrectAngle++;
                 }
 
                 // Write to file
-                myFile << std::to_string(ms) << ",";
-                myFile << std::to_string(gsr.groundSteering()) << ",";
-                myFile << std::to_string(calculatedAngle);
-                myFile << "\n";
-                
-                output.append(" CalAng: " + std::to_string(calculatedAngle));
-                cv::putText(img,                        // target image
-                            output,                     // text
-                            cv::Point(0, img.rows / 2), // top-left position
-                            cv::FONT_HERSHEY_PLAIN,
-                            1.0,
-                            CV_RGB(0, 0, 255),          // font color
-                            1);
-                // If you want to access the latest received ground steering, don't forget to lock the mutex:
-                {
-                    std::lock_guard<std::mutex> lck(gsrMutex);
+                steeringLog.log(makeSteeringRecord(frame));
+                watch.lap(loggingLatency);
 
-                    std::cout << "Group 15; " << std::to_string(ms) << "; " << std::to_string(calculatedAngle) << std::endl;
+                steeringOutput.emit(ms, calculatedAngle);
+                if (publisher)
+                {
+                    publisher->publish(ms, calculatedAngle);
+                }
+                if (!OFFLINE)
+                {
+                    const int64_t AGE = cluon::time::toMicroseconds(cluon::time::now()) - ms;
+                    frameAge.record(AGE > 0 ? static_cast<uint64_t>(AGE) * 1000 : 0);
                 }
 
-                // Display image on your screen.
-                if (VERBOSE)
+                // Display image on your screen, unless the frame is degraded to catch up.
+                if (VERBOSE && !frame.degraded)
                 {
-                    cv::imshow(sharedMemory->name().c_str(), img);
-                    cv::imshow("Cropped Image", cropedImg);
+                    std::string output = "TS: " + std::to_string(ms) + "; GROUND STEERING: " + std::to_string(frame.groundSteering);
+                    output.append(" CalAng: " + std::to_string(calculatedAngle));
+                    cv::putText(frame.image,                        // target image
+                                output,                             // text
+                                cv::Point(0, frame.image.rows / 2), // top-left position
+                                cv::FONT_HERSHEY_PLAIN,
+                                1.0,
+                                CV_RGB(0, 0, 255),                  // font color
+                                1);
+                    cv::imshow(sharedMemory ? sharedMemory->name().c_str() : "Frame", frame.image);
+                    cv::imshow("Cropped Image", frame.band);
                     cv::waitKey(1);
                 }
+                watch.lap(outputLatency);
+
+                if (latencyReportRequested.exchange(false))
+                {
+                    latencies.print(std::clog);
+                }
+            };
+
+            // Frames are recorded before anything is drawn onto them.
+            std::vector<FramePipeline::Stage> stages{segment, detect, estimate, emit};
+            if (archiveWriter)
+            {
+                stages.insert(stages.begin(), record);
+            }
+            // All frame buffers are allocated here, before the first frame arrives.
+            FramePipeline pipeline{acquire, stages, FrameWorkspace{catchUpFrameSlots(catchUpPolicy, stages.size(), static_cast<size_t>(BACKLOG)), acquisition}};
+            pipeline.run(PIPELINE);
+            steeringOutput.flush();
+            if (recording && recording->skippedFrames() > 0)
+            {
+                std::clog << argv[0] << ": Skipped " << recording->skippedFrames() << " images that could not be decoded." << std::endl;
+            }
+            if (archiveWriter)
+            {
+                std::clog << argv[0] << ": Recorded " << archiveWriter->frames() << " frames to " << RECORD << "." << std::endl;
+            }
+            if (steeringLog.dropped() > 0)
+            {
+                std::clog << argv[0] << ": Dropped " << steeringLog.dropped() << " steering log records." << std::endl;
             }
-            myFile.close();
+            std::clog << argv[0] << ": The blob detection used at most " << detector.scratchHighWater() << " of "
+                      << detector.scratchCapacity() << " bytes of per-frame scratch." << std::endl;
 
             // Calculate percentage and print result to the console
             double percentage = NrOfCorrectAngle / frames;
             std::cout << "Percentage: " << std::to_string(percentage) << std::endl;
             std::cout << "Frames: " << std::to_string(frames) << std::endl;
             std::cout << "Nr Correct Angle: " << std::to_string(NrOfCorrectAngle) << std::endl;
+            latencies.print(std::cout);
         }
         retCode = 0;
     }
     return retCode;
 }
-
-/*---------------- Functions ---------------------*/
-
-// This method returns the centre point of the cone
-cv::Point2f drawContourWithCentroidPoint(cv::Mat inputImage, cv::Mat outputImage, int contourArea, cv::Scalar contourColor, cv::Scalar centroidColor)
-{
-    std::vector<std::vector<cv::Point>> contours;
-    std::vector<cv::Vec4i> hierarchy;
-    // convert to gray scale
-    // draw blue cones' contour
-    cv::Mat img_channels[3];
-    cv::split(inputImage, img_channels);
-    cv::Mat img_gray = img_channels[0];
-    cv::findContours(img_gray, contours, hierarchy, cv::RETR_TREE, cv::CHAIN_APPROX_SIMPLE);
-    // get the moments
-    std::vector<cv::Moments> mu(contours.size());
-    std::vector<cv::Point2f> mc(mu.size());
-    cv::Point2f cone;
-
-    if (contours.size() > 0)
-    {
-        for (int i = 0; i < contours.size(); i++)
-        {
-            if (cv::contourArea(contours[i]) > contourArea)
-            {
-                mu[i] = cv::moments(contours[i], false);
-            }
-        }
-        // get the centroid of figures.
-        for (int i = 0; i < mu.size(); i++)
-        {
-            mc[i] = cv::Point2f(mu[i].m10 / mu[i].m00, mu[i].m01 / mu[i].m00);
-        }
-        for (int i = 0; i < mu.size(); i++)
-        {
-            circle(outputImage, mc[i], 4, centroidColor, -1, 8, 0);
-
-            if(mc[i].x > 0 ){
-                // then we have a value
-                cone = mc[i];
-            }
-        }
-    }
-    return cone;
-}
-
-// Method to calculate the steering wheel angle. Works for clockwise (blue cones on the left). We are assuming that the fram is 480px wide
-// and that the car's position is constant in the middle at 240px.
-double calculateSteeringWheelAngle(cv::Point2f blueCone, cv::Point2f yellowCone,int timestamp){
-    
-    double angle = 0.0;
-
-    if(blueCone.x < LEFT_THRESHOLD || yellowCone.x > RIGHT_THRESHOLD){
-        // ---------------------------
-        // |  B   |      |      |  Y  |
-        // ---------------------------
-        // No turn
-        angle = 0.0;
-
-    } else if (blueCone.x < CAR_POSITION && blueCone.x > LEFT_THRESHOLD){
-        // ---------------------------
-        // |     |   B   |      |     |
-        // ---------------------------   
-        // Turn right case 1
-        angle = -0.1;
-
-    } else if (blueCone.x > CAR_POSITION && blueCone.x < RIGHT_THRESHOLD) {
-        // ---------------------------
-        // |     |     |   B  |     |
-        // ---------------------------   
-        // Turn right case 2
-        angle = -0.2;
-
-    } else if (blueCone.x < 480 && blueCone.x > RIGHT_THRESHOLD) {
-        // ---------------------------
-        // |     |     |     |  B   |
-        // ---------------------------   
-        // Turn right case 3
-        angle = -0.25;
-    } else if (yellowCone.x < RIGHT_THRESHOLD && yellowCone.x > CAR_POSITION) {
-        // ---------------------------
-        // |     |     |   Y  |     |
-        // ---------------------------   
-        // Turn left case 1
-        angle = 0.1;
-    } else if (yellowCone.x < CAR_POSITION && yellowCone.x > LEFT_THRESHOLD) {
-        // ---------------------------
-        // |     |  Y   |     |     |
-        // ---------------------------   
-        // Turn left case 2
-        angle = 0.2;
-    } else if (yellowCone.x > 5 && yellowCone.x < LEFT_THRESHOLD) {
-        // ---------------------------
-        // | Y   |     |     |     |
-        // ---------------------------   
-        // Turn left case 3
-        angle = 0.25;
-    }
-    return angle;
-}
-
-// Method to calculate the steering wheel angle. Works for counter-clockwise (yellow cones on the left). We are assuming that the fram is 480px wide
-// and that the car's position is constant in the middle at 240px.
-double calculateSteeringWheelAngleCounter(cv::Point2f blueCone, cv::Point2f yellowCone,int timestamp){
-
-    double angle = 0.0;
-
-    if(yellowCone.x < LEFT_THRESHOLD || blueCone.x > RIGHT_THRESHOLD){
-        // ---------------------------
-        // |  Y   |      |      |  B  |
-        // ---------------------------
-        // No turn
-        angle = 0.0;
-
-    } else if (yellowCone.x < CAR_POSITION && yellowCone.x > LEFT_THRESHOLD){
-        // ---------------------------
-        // |     |   Y   |      |     |
-        // ---------------------------   
-        // Turn right case 1
-        angle = -0.1;
-
-    } else if (yellowCone.x > CAR_POSITION && yellowCone.x < RIGHT_THRESHOLD) {
-        // ---------------------------
-        // |     |     |  Y |     |
-        // ---------------------------   
-        // Turn right case 2
-        angle = -0.2;
-    }else if ( yellowCone.x > RIGHT_THRESHOLD && yellowCone.x < 480) {
-        // ---------------------------
-        // |     |     |     |   Y  |
-        // ---------------------------   
-        // Turn right case 3
-        angle = -0.25;
-    } else if (blueCone.x < LEFT_THRESHOLD && blueCone.x > CAR_POSITION) {
-        // ---------------------------
-        // |     |     |   B  |     |
-        // ---------------------------   
-        // Turn left case 1
-        angle = 0.1;
-    } else if (blueCone.x < CAR_POSITION && blueCone.x > LEFT_THRESHOLD) {
-        // ---------------------------
-        // |     |  B  |     |     |
-        // ---------------------------   
-        // Turn left case 2
-        angle = 0.2;
-    } else if (blueCone.x < LEFT_THRESHOLD && blueCone.x > 5) {
-        // ---------------------------
-        // |  B   |     |     |     |
-        // ---------------------------   
-        // Turn left case 3
-        angle = 0.25;
-    }
-
-    return angle;
-}
-
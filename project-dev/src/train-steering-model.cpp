@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2020  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cluon-complete.hpp"
+#include "Evaluation.hpp"
+#include "PolynomialSteeringModel.hpp"
+#include "SteeringLog.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Correct angles of the model on the logs, each started with a fresh model.
+uint64_t correctAngles(const PolynomialSteeringParameters &parameters, const std::vector<std::vector<SteeringRecord>> &logs)
+{
+    uint64_t correct = 0;
+    for (const std::vector<SteeringRecord> &records : logs)
+    {
+        PolynomialSteeringModel model{parameters};
+        for (const SteeringRecord &record : records)
+        {
+            correct += isCorrectAngle(model.estimate(makeSteeringFeatures(record)), record.groundSteering) ? 1 : 0;
+        }
+    }
+    return correct;
+}
+
+// Correct angles the logs were written with, i.e. of the estimator that wrote them.
+uint64_t loggedCorrectAngles(const std::vector<std::vector<SteeringRecord>> &logs)
+{
+    uint64_t correct = 0;
+    for (const std::vector<SteeringRecord> &records : logs)
+    {
+        for (const SteeringRecord &record : records)
+        {
+            correct += isCorrectAngle(record.calculatedAngle, record.groundSteering) ? 1 : 0;
+        }
+    }
+    return correct;
+}
+
+bool readSteeringLogs(const std::string &fileNames, std::vector<std::vector<SteeringRecord>> &logs, size_t &frames, std::string &error)
+{
+    // stringtoolbox::split returns nothing for a single name, so the list is split here.
+    std::istringstream list(fileNames);
+    std::string fileName;
+    while (std::getline(list, fileName, ','))
+    {
+        std::vector<SteeringRecord> records;
+        if (!readSteeringLog(fileName, records))
+        {
+            error = fileName + " is not a steering log";
+            return false;
+        }
+        frames += records.size();
+        logs.push_back(std::move(records));
+    }
+    return true;
+}
+
+void printAccuracy(const std::string &name, uint64_t correct, size_t frames)
+{
+    std::cout << name << ": Percentage: " << std::to_string(frames > 0 ? static_cast<double>(correct) / static_cast<double>(frames) : 0.0)
+              << " (" << correct << " of " << frames << ")" << std::endl;
+}
+
+// Fits the weights of the polynomial steering model to the ground truth of steering logs.
+int32_t main(int32_t argc, char **argv)
+{
+    int32_t retCode{1};
+    auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
+    if ((0 == commandlineArguments.count("log")) || (0 == commandlineArguments.count("model")))
+    {
+        std::cerr << argv[0] << " fits the polynomial steering model to the ground truth of steering logs." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << " --log=<steering log>[,<steering log>...] --model=<output file> [--test=<steering log>[,...]] [--ridge=<weight>]" << std::endl;
+        std::cerr << "         --log:   steering logs written by template-opencv, e.g. with --rec or --archive; each log must be one drive" << std::endl;
+        std::cerr << "         --model: file to write the model to, use it with template-opencv --model" << std::endl;
+        std::cerr << "         --test:  steering logs that are not fitted to but only evaluated" << std::endl;
+        std::cerr << "         --ridge: regularisation of the weights per frame (default: 0.001)" << std::endl;
+        std::cerr << "Example: " << argv[0] << " --log=a.log,b.log --test=c.log --model=steering.model" << std::endl;
+    }
+    else
+    {
+        const double RIDGE{(commandlineArguments.count("ridge") != 0) ? std::stod(commandlineArguments["ridge"]) : 0.001};
+        std::vector<std::vector<SteeringRecord>> trainingLogs;
+        std::vector<std::vector<SteeringRecord>> testLogs;
+        size_t trainingFrames = 0;
+        size_t testFrames = 0;
+        std::string error;
+        if (!readSteeringLogs(commandlineArguments["log"], trainingLogs, trainingFrames, error) ||
+            (commandlineArguments.count("test") != 0 && !readSteeringLogs(commandlineArguments["test"], testLogs, testFrames, error)))
+        {
+            std::cerr << argv[0] << ": " << error << "." << std::endl;
+            return retCode;
+        }
+
+        PolynomialSteeringParameters parameters{};
+        if (!fitPolynomialSteeringModel(trainingLogs, RIDGE, parameters, error))
+        {
+            std::cerr << argv[0] << ": " << error << "." << std::endl;
+            return retCode;
+        }
+        std::ofstream model(commandlineArguments["model"]);
+        writeSteeringModel(model, parameters);
+        if (!model)
+        {
+            std::cerr << argv[0] << ": Could not write " << commandlineArguments["model"] << "." << std::endl;
+            return retCode;
+        }
+
+        printAccuracy("Logged angles", loggedCorrectAngles(trainingLogs), trainingFrames);
+        printAccuracy("Model", correctAngles(parameters, trainingLogs), trainingFrames);
+        if (!testLogs.empty())
+        {
+            printAccuracy("Logged angles (test)", loggedCorrectAngles(testLogs), testFrames);
+            printAccuracy("Model (test)", correctAngles(parameters, testLogs), testFrames);
+        }
+        retCode = 0;
+    }
+    return retCode;
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2020  Christian Berger
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cluon-complete.hpp"
+#include "ConeColorTable.hpp"
+#include "H264Decoder.hpp"
+#include "ParameterTuner.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+
+ParameterRange single(int value)
+{
+    return ParameterRange{value, value, 1};
+}
+
+// Parses "first:last:step", "first:last" (step 1) or a single value; without the option the current value is kept.
+ParameterRange parseRange(std::map<std::string, std::string> &commandlineArguments, const std::string &name, int currentValue)
+{
+    if (0 == commandlineArguments.count(name))
+    {
+        return single(currentValue);
+    }
+    const std::vector<std::string> FIELDS = stringtoolbox::split(commandlineArguments[name], ':');
+    const int FIRST = std::stoi(FIELDS.at(0));
+    return ParameterRange{FIRST, FIELDS.size() > 1 ? std::stoi(FIELDS[1]) : FIRST, FIELDS.size() > 2 ? std::stoi(FIELDS[2]) : 1};
+}
+
+std::string describeTuningMode(const TuningMode &mode)
+{
+    std::string description{mode.exactSegmentation ? "exact segmentation" : "lookup table with " + std::to_string(mode.lutBits) + " bits per channel"};
+    description += mode.tracking ? ", tracked cones" : ", cones as detected (--no-tracking)";
+    return description;
+}
+
+void printParameters(const TuningParameters &parameters, uint32_t frameWidth)
+{
+    std::cout << "// Yellow hsv values" << std::endl;
+    std::cout << "const int MIN_HUE_Y = " << parameters.yellow.minHue << ";" << std::endl;
+    std::cout << "const int MAX_HUE_Y = " << parameters.yellow.maxHue << ";" << std::endl;
+    std::cout << "const int MIN_SAT_Y = " << parameters.yellow.minSat << ";" << std::endl;
+    std::cout << "const int MAX_SAT_Y = " << parameters.yellow.maxSat << ";" << std::endl;
+    std::cout << "const int MIN_VAL_Y = " << parameters.yellow.minVal << ";" << std::endl;
+    std::cout << "const int MAX_VAL_Y = " << parameters.yellow.maxVal << ";" << std::endl;
+    std::cout << "// Blue hsv values" << std::endl;
+    std::cout << "const int MIN_HUE_B = " << parameters.blue.minHue << ";" << std::endl;
+    std::cout << "const int MAX_HUE_B = " << parameters.blue.maxHue << ";" << std::endl;
+    std::cout << "const int MIN_SAT_B = " << parameters.blue.minSat << ";" << std::endl;
+    std::cout << "const int MAX_SAT_B = " << parameters.blue.maxSat << ";" << std::endl;
+    std::cout << "const int MIN_VAL_B = " << parameters.blue.minVal << ";" << std::endl;
+    std::cout << "const int MAX_VAL_B = " << parameters.blue.maxVal << ";" << std::endl;
+    std::cout << "// Car's position and thresholds, for frames " << frameWidth << " pixels wide" << std::endl;
+    std::cout << "const int CAR_POSITION = " << parameters.steering.carPosition << ";" << std::endl;
+    std::cout << "const int LEFT_THRESHOLD = " << parameters.steering.leftThreshold << ";" << std::endl;
+    std::cout << "const int RIGHT_THRESHOLD = " << parameters.steering.rightThreshold << ";" << std::endl;
+}
+
+int32_t main(int32_t argc, char **argv)
+{
+    int32_t retCode{1};
+    auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
+    if ((0 == commandlineArguments.count("rec")) ||
+        (0 == commandlineArguments.count("width")) ||
+        (0 == commandlineArguments.count("height")))
+    {
+        std::cerr << argv[0] << " searches the HSV ranges and steering thresholds with the most correct angles on recordings." << std::endl;
+        std::cerr << "Usage:   " << argv[0] << " --rec=<recording>[,<recording>...] --width=<width> --height=<height> [parameter ranges]" << std::endl;
+        std::cerr << "         --width:  width of the frames" << std::endl;
+        std::cerr << "         --height: height of the frames" << std::endl;
+        std::cerr << "         --roi-top, --roi-bottom, --roi-left, --roi-right: band of the frame to process (default: rows 310-360 of 480, scaled to --height, full width)" << std::endl;
+        std::cerr << "         --segmentation: 'lut' (default) or 'exact', as in template-opencv" << std::endl;
+        std::cerr << "         --lut-bits: bits per colour channel of the lookup table, 8 is exact (default: 6)" << std::endl;
+        std::cerr << "         --no-tracking: score the cones as detected in each frame instead of tracking them" << std::endl;
+        std::cerr << "         --threads: threads for the search (default: number of cores)" << std::endl;
+        std::cerr << "         Parameter ranges are given as first:last:step; parameters without a range keep their current value:" << std::endl;
+        std::cerr << "         --min-hue-b, --max-hue-b, --min-sat-b, --max-sat-b, --min-val-b, --max-val-b: blue cone HSV range" << std::endl;
+        std::cerr << "         --min-hue-y, --max-hue-y, --min-sat-y, --max-sat-y, --min-val-y, --max-val-y: yellow cone HSV range" << std::endl;
+        std::cerr << "         --car-position, --left-threshold, --right-threshold: steering thresholds" << std::endl;
+        std::cerr << "Example: " << argv[0] << " --rec=a.rec,b.rec --width=640 --height=480 --min-hue-b=90:110:5 --min-sat-y=60:90:10 --car-position=200:280:20" << std::endl;
+    }
+    else if (!H264Decoder::available())
+    {
+        std::cerr << argv[0] << ": The recordings cannot be decoded; rebuild with openh264 installed." << std::endl;
+    }
+    else
+    {
+        const uint32_t WIDTH{static_cast<uint32_t>(std::stoi(commandlineArguments["width"]))};
+        const uint32_t HEIGHT{static_cast<uint32_t>(std::stoi(commandlineArguments["height"]))};
+        const RegionOfInterest DEFAULT_ROI{defaultRegionOfInterest(WIDTH, HEIGHT)};
+        const RegionOfInterest ROI{
+            (commandlineArguments.count("roi-top") != 0) ? std::stoi(commandlineArguments["roi-top"]) : DEFAULT_ROI.top,
+            (commandlineArguments.count("roi-bottom") != 0) ? std::stoi(commandlineArguments["roi-bottom"]) : DEFAULT_ROI.bottom,
+            (commandlineArguments.count("roi-left") != 0) ? std::stoi(commandlineArguments["roi-left"]) : 0,
+            (commandlineArguments.count("roi-right") != 0) ? std::stoi(commandlineArguments["roi-right"]) : static_cast<int>(WIDTH)};
+        if (!ROI.validFor(WIDTH, HEIGHT))
+        {
+            std::cerr << argv[0] << ": --roi-top, --roi-bottom, --roi-left and --roi-right must give 0 <= top < bottom <= " << HEIGHT
+                      << " and 0 <= left < right <= " << WIDTH << "." << std::endl;
+            return retCode;
+        }
+        const TuningMode MODE{
+            commandlineArguments["segmentation"] == "exact",
+            (commandlineArguments.count("lut-bits") != 0) ? std::stoi(commandlineArguments["lut-bits"]) : DEFAULT_TUNING_MODE.lutBits,
+            commandlineArguments.count("no-tracking") == 0};
+        if (!ConeColorTable::validBitsPerChannel(MODE.lutBits))
+        {
+            std::cerr << argv[0] << ": --lut-bits must be between " << ConeColorTable::MIN_BITS_PER_CHANNEL << " and "
+                      << ConeColorTable::MAX_BITS_PER_CHANNEL << "." << std::endl;
+            return retCode;
+        }
+        const size_t THREADS{(commandlineArguments.count("threads") != 0) ? static_cast<size_t>(std::stoi(commandlineArguments["threads"])) : std::max(1u, std::thread::hardware_concurrency())};
+
+        const HsvRangeGrid BLUE_GRID{
+            parseRange(commandlineArguments, "min-hue-b", MIN_HUE_B), parseRange(commandlineArguments, "max-hue-b", MAX_HUE_B),
+            parseRange(commandlineArguments, "min-sat-b", MIN_SAT_B), parseRange(commandlineArguments, "max-sat-b", MAX_SAT_B),
+            parseRange(commandlineArguments, "min-val-b", MIN_VAL_B), parseRange(commandlineArguments, "max-val-b", MAX_VAL_B)};
+        const HsvRangeGrid YELLOW_GRID{
+            parseRange(commandlineArguments, "min-hue-y", MIN_HUE_Y), parseRange(commandlineArguments, "max-hue-y", MAX_HUE_Y),
+            parseRange(commandlineArguments, "min-sat-y", MIN_SAT_Y), parseRange(commandlineArguments, "max-sat-y", MAX_SAT_Y),
+            parseRange(commandlineArguments, "min-val-y", MIN_VAL_Y), parseRange(commandlineArguments, "max-val-y", MAX_VAL_Y)};
+        // The current thresholds, scaled to the width of the recordings.
+        const SteeringThresholds THRESHOLDS{scaledSteeringThresholds(DEFAULT_STEERING_THRESHOLDS, WIDTH)};
+        const SteeringGrid STEERING_GRID{
+            parseRange(commandlineArguments, "car-position", THRESHOLDS.carPosition),
+            parseRange(commandlineArguments, "left-threshold", THRESHOLDS.leftThreshold),
+            parseRange(commandlineArguments, "right-threshold", THRESHOLDS.rightThreshold)};
+
+        // Decode every recording once; all candidates are evaluated on the frames in memory.
+        const auto START = std::chrono::steady_clock::now();
+        FrameAcquisition acquisition{WIDTH, HEIGHT, ROI, false};
+        ParameterTuner tuner{THREADS, MODE};
+        for (const std::string &fileName : stringtoolbox::split(commandlineArguments["rec"], ','))
+        {
+            TuningRecording recording;
+            if (!loadTuningRecording(fileName, acquisition, MODE, recording))
+            {
+                std::cerr << argv[0] << ": Could not read the recording " << fileName << "." << std::endl;
+                return retCode;
+            }
+            std::clog << argv[0] << ": Loaded " << recording.hsvBands.size() << " frames from " << fileName << "." << std::endl;
+            tuner.addRecording(std::move(recording));
+        }
+        const auto LOADED = std::chrono::steady_clock::now();
+
+        const TuningResult CURRENT = tuner.tune(
+            HsvRangeGrid{single(MIN_HUE_B), single(MAX_HUE_B), single(MIN_SAT_B), single(MAX_SAT_B), single(MIN_VAL_B), single(MAX_VAL_B)},
+            HsvRangeGrid{single(MIN_HUE_Y), single(MAX_HUE_Y), single(MIN_SAT_Y), single(MAX_SAT_Y), single(MIN_VAL_Y), single(MAX_VAL_Y)},
+            SteeringGrid{single(THRESHOLDS.carPosition), single(THRESHOLDS.leftThreshold), single(THRESHOLDS.rightThreshold)}, THRESHOLDS);
+        const TuningResult BEST = tuner.tune(BLUE_GRID, YELLOW_GRID, STEERING_GRID, THRESHOLDS);
+        const auto DONE = std::chrono::steady_clock::now();
+
+        std::cout << "Tuned for: " << describeTuningMode(MODE) << std::endl;
+        std::cout << "Current parameters: Percentage: " << std::to_string(CURRENT.accuracy()) << std::endl;
+        std::cout << "Best of " << BEST.candidates << " combinations: Percentage: " << std::to_string(BEST.accuracy()) << std::endl;
+        std::cout << "Frames: " << BEST.frames << std::endl;
+        std::cout << "Nr Correct Angle: " << BEST.correctAngles << std::endl;
+        printParameters(BEST.best, WIDTH);
+        std::clog << argv[0] << ": Loading took " << std::to_string(std::chrono::duration<double>(LOADED - START).count())
+                  << " s, the search " << std::to_string(std::chrono::duration<double>(DONE - LOADED).count()) << " s." << std::endl;
+        retCode = 0;
+    }
+    return retCode;
+}